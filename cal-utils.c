@@ -1,9 +1,12 @@
 #define _GNU_SOURCE
+#include <elf.h>
 #include <fcntl.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
+#include <sys/stat.h>
 #include <unistd.h>
 #include <cal.h>
 #include <calcl.h>
@@ -93,74 +96,216 @@ void display_attribs(CALdeviceattribs *a)
         a->b3dProgramGrid, a->numberOfShaderEngines, a->targetRevision);
 }
 
-static void advance(char **area, unsigned *remaining, const char *marker)
+/*
+ * Locates the ISA of the first encoding of a CAL ELF object or image: the
+ * program headers list, for each encoding, a PT_NOTE segment of "ATI CAL"
+ * notes, then a PT_LOAD segment with the instructions, then one with the data.
+ *
+ * buf           ELF object
+ * max_size      Bytes that can be read at buf, at most
+ * elf           Receives the locations
+ *
+ * Returns false, after reporting the problem, if buf is not as expected.
+ */
+bool cal_elf_parse(const uint8_t *buf, uint32_t max_size, cal_elf_t *elf)
 {
-    char *find = memmem(*area, *remaining, marker, strlen(marker));
-    if (!find)
-        fprintf(stderr, "Marker \"%s\" not found\n", marker), exit(1);
-    *remaining -= find - *area;
-    *area = find;
+    const Elf32_Ehdr *eh = (const void *)buf;
+    const char *err = NULL;
+    uint32_t end;
+    int note = -1;
+    memset(elf, 0, sizeof (*elf));
+    if (max_size < sizeof (*eh) || memcmp(eh->e_ident, ELFMAG, SELFMAG) ||
+            eh->e_ident[EI_CLASS] != ELFCLASS32)
+      {
+        err = "not an ELF32 file";
+        goto out;
+      }
+    if (eh->e_phentsize != sizeof (Elf32_Phdr) || !eh->e_phnum ||
+            eh->e_phoff + eh->e_phnum * sizeof (Elf32_Phdr) > max_size)
+      {
+        err = "bad program header table";
+        goto out;
+      }
+    const Elf32_Phdr *ph = (const void *)(buf + eh->e_phoff);
+    elf->size = eh->e_phoff + eh->e_phnum * sizeof (Elf32_Phdr);
+    if (eh->e_shnum && (end = eh->e_shoff + eh->e_shnum * eh->e_shentsize) >
+            elf->size)
+        elf->size = end;
+    for (int i = 0; i < eh->e_phnum; i++)
+      {
+        if ((end = ph[i].p_offset + ph[i].p_filesz) < ph[i].p_offset ||
+                end > max_size)
+          {
+            err = "segment out of bounds";
+            goto out;
+          }
+        if (end > elf->size)
+            elf->size = end;
+      }
+    // the notes of the first encoding
+    for (int i = 0; i < eh->e_phnum && note == -1; i++)
+      {
+        if (ph[i].p_type != PT_NOTE)
+            continue;
+        uint32_t off = ph[i].p_offset;
+        end = off + ph[i].p_filesz;
+        while (off + sizeof (Elf32_Nhdr) <= end)
+          {
+            const Elf32_Nhdr *nh = (const void *)(buf + off);
+            uint32_t name = off + sizeof (*nh);
+            uint32_t desc = name + ((nh->n_namesz + 3) & ~3U);
+            off = desc + ((nh->n_descsz + 3) & ~3U);
+            if (off > end || desc > end)
+                break;
+            if (nh->n_namesz == sizeof (CAL_NOTE_NAME) &&
+                    !memcmp(buf + name, CAL_NOTE_NAME, sizeof (CAL_NOTE_NAME)))
+              {
+                elf->nr_notes++;
+                note = i;
+              }
+          }
+      }
+    if (note == -1)
+      {
+        err = "no \"" CAL_NOTE_NAME "\" note";
+        goto out;
+      }
+    for (int i = note + 1; i < eh->e_phnum; i++)
+        if (ph[i].p_type == PT_LOAD)
+          {
+            elf->text_off = ph[i].p_offset;
+            elf->text_size = ph[i].p_filesz;
+            break;
+          }
+    if (!elf->text_size || elf->text_size % 8)
+        err = "no instruction segment";
+out:
+    if (err)
+        fprintf(stderr, "Invalid CAL ELF object: %s\n", err);
+    return !err;
 }
 
-static void patch_opcodes(int verbose, char *w, unsigned remaining,
-        int expected_min, int expected_max)
+/*
+ * Walks the instructions of an ALU clause, patching BFE_INT into BFI_INT
+ * unless dry_run. Each instruction group (ended by the LAST bit) is followed
+ * by the literal constants it uses, in pairs.
+ */
+static void walk_alu_clause(uint64_t *insn, unsigned count, bool dry_run,
+        alu_stats_t *st)
 {
-    uint64_t *opcode = (uint64_t *)w;
-    int patched = 0;
-    int count_bfe_int = 0;
-    int count_bfe_uint = 0;
-    int count_byte_align = 0;
-    while (42)
+    unsigned i = 0;
+    while (i < count)
       {
-        int clamp = (*opcode >> (32 + 31)) & 0x1;
-        //int dest_chan = (*opcode >> (32 + 29)) & 0x3;
-        int dest_rel = (*opcode >> (32 + 28)) & 0x1;
-        //int bank_swizzle = (*opcode >> (32 + 18)) & 0x7;
-        int alu_inst = (*opcode >> (32 + 13)) & 0x1f;
-        int s2_neg = (*opcode >> (32 + 12)) & 0x1;
-        //int s2_chan = (*opcode >> (32 + 10)) & 0x3;
-        int s2_rel = (*opcode >> (32 + 9)) & 0x1;
-        //int s2_sel = (*opcode >> (32 + 0)) & 0x1ff;
-        //int last = (*opcode >> 31) & 0x1;
-        int pred_sel = (*opcode >> 29) & 0x3;
-        int index_mode = (*opcode >> 26) & 0x7;
-        int s1_neg = (*opcode >> 25) & 0x1;
-        //int s1_chan = (*opcode >> 23) & 0x3;
-        int s1_rel = (*opcode >> 22) & 0x1;
-        //int s1_sel = (*opcode >> 13) & 0x1ff;
-        int s0_neg = (*opcode >> 12) & 0x1;
-        //int s0_chan = (*opcode >> 10) & 0x3;
-        int s0_rel = (*opcode >> 9) & 0x1;
-        //int s0_sel = (*opcode >> 0) & 0x1ff;
-        if (!clamp && !dest_rel && !s2_neg && !s2_rel && !pred_sel &&
-                !index_mode && !s1_neg && !s1_rel && !s0_neg && !s0_rel) {
-            if (alu_inst == OP3_INST_BFE_INT) {
-                count_bfe_int++;
-                // patch this instruction to BFI_INT
-                *opcode &= 0xfffc1fffffffffffUL;
-                *opcode |= OP3_INST_BFI_INT << (32 + 13);
-                patched++;
-            } else if (alu_inst == OP3_INST_BFE_UINT) {
-                count_bfe_uint++;
-            } else if (alu_inst == OP3_INST_BYTE_ALIGN_INT) {
-                count_byte_align++;
-            }
-        }
-        if (remaining <= 8) {
-            break;
-        }
-        opcode++;
-        remaining -= 8;
+        int literals = 0;
+        uint64_t w;
+        st->groups++;
+        do
+          {
+            w = insn[i++];
+            int sel[3] = { w & 0x1ff, (w >> 13) & 0x1ff, (w >> 32) & 0x1ff };
+            int chan[3] = { (w >> 10) & 3, (w >> 23) & 3, (w >> 42) & 3 };
+            int alu_inst = (w >> (32 + 13)) & 0x1f;
+            // OP3 instructions have a non-zero ALU_INST in those bits, OP2
+            // ones (with a longer ALU_INST field) a zero
+            bool op3 = alu_inst >= 4;
+            st->slots++;
+            for (int s = 0; s < (op3 ? 3 : 2); s++)
+                if (sel[s] == ALU_SRC_LITERAL && chan[s] >= literals)
+                    literals = chan[s] + 1;
+            if (!op3)
+                continue;
+            if (alu_inst == OP3_INST_BFE_INT)
+              {
+                st->bfe_int++;
+                if (dry_run)
+                    continue;
+                w &= 0xfffc1fffffffffffUL;
+                w |= OP3_INST_BFI_INT << (32 + 13);
+                insn[i - 1] = w;
+              }
+            else if (alu_inst == OP3_INST_BFE_UINT)
+                st->bfe_uint++;
+            else if (alu_inst == OP3_INST_BIT_ALIGN_INT)
+                st->bit_align++;
+            else if (alu_inst == OP3_INST_BYTE_ALIGN_INT)
+                st->byte_align++;
+          }
+        while (!((w >> 31) & 1) && i < count);
+        st->literals += literals;
+        i += (literals + 1) / 2;
       }
-    if (verbose > 1)
-        printf("Potential OP3 instructions identified: "
-                "%i BFE_INT, %i BFE_UINT, %i BYTE_ALIGN\n",
-                count_bfe_int, count_bfe_uint, count_byte_align);
-    if (verbose)
-        printf("Patched a total of %i BFI_INT instructions\n", patched);
-    if (patched < expected_min || patched > expected_max)
-        fprintf(stderr, "Error: patched %i instructions, was expecting %i-%i\n",
-                patched, expected_min, expected_max), exit(1);
+}
+
+static void add_stats(alu_stats_t *sum, const alu_stats_t *st)
+{
+    sum->groups += st->groups;
+    sum->slots += st->slots;
+    sum->literals += st->literals;
+    sum->bfe_int += st->bfe_int;
+    sum->bfe_uint += st->bfe_uint;
+    sum->bit_align += st->bit_align;
+    sum->byte_align += st->byte_align;
+}
+
+/*
+ * Walks the control flow program at the start of the ISA to find the ALU
+ * clauses, which are placed after it, and walks each of them. Returns the
+ * number of clauses, or -1 if the program is malformed.
+ *
+ * verbose       A value above 1 prints per-clause statistics
+ */
+int walk_alu_clauses(int verbose, uint8_t *text, uint32_t text_size,
+        bool dry_run, alu_stats_t *total)
+{
+    uint32_t nr_words = text_size / 8;
+    uint32_t cf_end = nr_words; // the first clause
+    uint64_t *words = (void *)text;
+    int nr_clauses = 0;
+    memset(total, 0, sizeof (*total));
+    for (uint32_t pc = 0; pc < cf_end; pc++)
+      {
+        uint32_t w0 = words[pc], w1 = words[pc] >> 32;
+        uint32_t addr, count;
+        if (w1 & CF_ALU_BIT)
+          {
+            // CF_ALU_WORD0/1
+            if (((w1 >> 26) & 0xf) == CF_INST_ALU_EXTENDED)
+                continue; // extends the kcache of the next ALU clause
+            addr = w0 & 0x3fffff;
+            count = ((w1 >> 18) & 0x7f) + 1;
+          }
+        else
+          {
+            // CF_WORD0/1
+            unsigned cf_inst = (w1 >> 22) & 0xff;
+            if (cf_inst == CF_INST_TC || cf_inst == CF_INST_VC)
+              {
+                addr = w0 & 0xffffff;
+                if (addr < cf_end)
+                    cf_end = addr;
+              }
+            if ((w1 & CF_END_OF_PROGRAM_BIT) || cf_inst == CF_INST_END)
+                break;
+            continue;
+          }
+        if (addr < pc || addr + count > nr_words)
+          {
+            fprintf(stderr, "ALU clause at CF %u out of bounds\n", pc);
+            return -1;
+          }
+        if (addr < cf_end)
+            cf_end = addr;
+        alu_stats_t st = { 0 };
+        walk_alu_clause(words + addr, count, dry_run, &st);
+        if (verbose > 1)
+            printf("ALU clause %i at 0x%x: %i groups, %i slots, %i literals, "
+                    "%i BFE_INT, %i BFE_UINT, %i BIT_ALIGN, %i BYTE_ALIGN\n",
+                    nr_clauses, addr * 8, st.groups, st.slots, st.literals,
+                    st.bfe_int, st.bfe_uint, st.bit_align, st.byte_align);
+        add_stats(total, &st);
+        nr_clauses++;
+      }
+    return nr_clauses;
 }
 
 /*
@@ -169,8 +314,6 @@ static void patch_opcodes(int verbose, char *w, unsigned remaining,
  * Note: BEWARE of IL compiler optimizations. Only use a fake ibit_extract
  * when the register values cannot be known by the compiler.
  *
- * Requires the IL code to have a comment near the end of "_the_end_".
- *
  * BFI_INT src0=mask  src1=data_if_mask_1 src2=data_of_mask_0
  * BFE_INT src0=input src1=offset         src2=width
  * ibit_extract dst, width, offset, input
@@ -178,42 +321,237 @@ static void patch_opcodes(int verbose, char *w, unsigned remaining,
  *
  * verbose       Non-zero increases verbosity
  * obj           ELF CALobject to patch
- * bytes_to_scan Number of bytes to assume the ELF CALobject contains
+ * max_size      Max number of bytes the ELF CALobject can contain
  * expected_min  Min number of BFE_INT instr. that were expected to be patched
  * expected_max  Max number of BFE_INT instr. that were expected to be patched
  */
 void patch_bfi_int_instructions(int verbose, CALobject *obj,
-        unsigned bytes_to_scan, int expected_min, int expected_max)
+        unsigned max_size, int expected_min, int expected_max)
 {
+    uint8_t *buf = (void *)*obj;
+    alu_stats_t st;
+    cal_elf_t elf;
     if (verbose > 1)
         printf("Patching BFI_INT instructions into the binary CAL object...\n");
-    if (0) {
-        int fd = open("obj.elf", O_CREAT|O_WRONLY|O_TRUNC, 0666);
-        if (fd == -1)
-            perror("obj.elf"), exit(1);
-        if (-1 == write(fd, *obj, bytes_to_scan))
-	    perror("write"), exit(1);
-        close(fd);
-    }
-    unsigned remaining = bytes_to_scan;
-    char *w = (void *)*obj;
+    if (!cal_elf_parse(buf, max_size, &elf))
+        exit(1);
     if (verbose > 1)
-        printf("At %p (%u rem. bytes), searching end marker\n", w, remaining);
-    advance(&w, &remaining, "_the_end_");
-    // advance until the 17th "ATI CAL" marker is encountered
-    const int ati_cal_markers = 17;
-    for (int i = 0; i < ati_cal_markers; i++) {
-        if (verbose > 1)
-            printf("At %p (%u rem. bytes), searching ATI CAL marker %i\n",
-                    w, remaining, i);
-        advance(&w, &remaining, "ATI CAL");
-        if (remaining < 1)
-            fprintf(stderr, "Only %u rem. bytes\n", remaining), exit(1);
-        w++; remaining--;
-    }
-    if (remaining < 11)
-        fprintf(stderr, "Only %u rem. bytes\n", remaining), exit(1);
-    w += 11; remaining -= 11;
-    // now we are pointing to the first opcode
-    patch_opcodes(verbose, w, remaining, expected_min, expected_max);
+        printf("%i \"" CAL_NOTE_NAME "\" notes, ISA at 0x%x (%u bytes)\n",
+                elf.nr_notes, elf.text_off, elf.text_size);
+    int nr_clauses = walk_alu_clauses(verbose, buf + elf.text_off,
+            elf.text_size, false, &st);
+    if (nr_clauses < 0)
+        exit(1);
+    if (verbose)
+        printf("Patched a total of %i BFI_INT instructions in %i ALU "
+                "clauses\n", st.bfe_int, nr_clauses);
+    if (st.bfe_int < expected_min || st.bfe_int > expected_max)
+        fprintf(stderr, "Error: patched %i instructions, was expecting %i-%i\n",
+                st.bfe_int, expected_min, expected_max), exit(1);
+}
+
+/*
+ * Saves a compiled ELF CALobject (before patching), eg. to analyze it offline
+ * with analyze_cal_object.
+ */
+void save_cal_object(const char *path, CALobject *obj, unsigned max_size)
+{
+    cal_elf_t elf;
+    if (!cal_elf_parse((void *)*obj, max_size, &elf))
+        exit(1);
+    int fd = open(path, O_CREAT|O_WRONLY|O_TRUNC, 0666);
+    if (fd == -1)
+        perror(path), exit(1);
+    if (-1 == write(fd, *obj, elf.size))
+        perror("write"), exit(1);
+    close(fd);
+}
+
+/*
+ * Prints the layout and ALU clause statistics of a saved ELF CALobject, as
+ * patch_bfi_int_instructions would see it. Needs no CAL device.
+ */
+void analyze_cal_object(int verbose, const char *path)
+{
+    struct stat sb;
+    alu_stats_t st;
+    cal_elf_t elf;
+    int fd = open(path, O_RDONLY);
+    if (fd == -1 || fstat(fd, &sb) == -1)
+        perror(path), exit(1);
+    uint8_t *buf = malloc(sb.st_size);
+    if (!buf)
+        perror("malloc"), exit(1);
+    if (read(fd, buf, sb.st_size) != sb.st_size)
+        perror("read"), exit(1);
+    close(fd);
+    if (!cal_elf_parse(buf, sb.st_size, &elf))
+        exit(1);
+    printf("%s: %u bytes, %i \"" CAL_NOTE_NAME "\" notes, ISA at 0x%x "
+            "(%u bytes)\n", path, elf.size, elf.nr_notes, elf.text_off,
+            elf.text_size);
+    int nr_clauses = walk_alu_clauses(verbose + 2, buf + elf.text_off,
+            elf.text_size, true, &st);
+    if (nr_clauses < 0)
+        exit(1);
+    printf("Total: %i ALU clauses, %i groups, %i slots, %i literals, "
+            "%i BFE_INT (to patch), %i BFE_UINT, %i BIT_ALIGN, "
+            "%i BYTE_ALIGN\n", nr_clauses, st.groups, st.slots, st.literals,
+            st.bfe_int, st.bfe_uint, st.bit_align, st.byte_align);
+    free(buf);
+}
+
+static uint8_t *image_bytes(CALimage img, CALuint *size)
+{
+    if (CAL_RESULT_OK != calclImageGetSize(size, img))
+        fatal("calclImageGetSize");
+    uint8_t *bytes = malloc(*size);
+    if (!bytes)
+        perror("malloc"), exit(1);
+    if (CAL_RESULT_OK != calclImageWrite(bytes, *size, img))
+        fatal("calclImageWrite");
+    return bytes;
+}
+
+/*
+ * Locates nr_values literals in the images of the same kernel compiled with
+ * two sets of distinct sentinel values (values_a and values_b, at most 31
+ * values). A site is an
+ * offset holding values_a[i] in img_a and values_b[i] in img_b. This fails
+ * (returns false) unless the images are identical outside the sites and
+ * every value has at least one site, ie. unless the compiler used the values
+ * verbatim, without folding them into other constants.
+ *
+ * p             Receives img_a serialized, and the sites
+ */
+bool image_patch_init(image_patch_t *p, CALimage img_a, CALimage img_b,
+        const uint32_t *values_a, const uint32_t *values_b, int nr_values)
+{
+    CALuint size_b;
+    uint8_t *b = image_bytes(img_b, &size_b);
+    int max_sites = 0, found = 0;
+    const char *err = NULL;
+    p->bytes = image_bytes(img_a, &p->size);
+    p->nr_sites = 0;
+    p->sites = NULL;
+    if (p->size != size_b)
+      {
+        err = "image size depends on the literals";
+        goto out;
+      }
+    for (CALuint off = 0; off + 4 <= p->size; off++)
+      {
+        uint32_t va, vb;
+        memcpy(&va, p->bytes + off, 4);
+        memcpy(&vb, b + off, 4);
+        int i = 0;
+        while (i < nr_values && (va != values_a[i] || vb != values_b[i]))
+            i++;
+        if (i == nr_values)
+          {
+            if (p->bytes[off] != b[off])
+              {
+                err = "image differs outside of the literals";
+                goto out;
+              }
+            continue;
+          }
+        if (p->nr_sites == max_sites)
+          {
+            max_sites = max_sites ? 2 * max_sites : 64;
+            p->sites = realloc(p->sites, max_sites * sizeof (*p->sites));
+            if (!p->sites)
+                perror("realloc"), exit(1);
+          }
+        p->sites[p->nr_sites].offset = off;
+        p->sites[p->nr_sites].idx = i;
+        p->nr_sites++;
+        found |= 1 << i;
+        off += 3;
+      }
+    if (found != (1 << nr_values) - 1)
+        err = "some literals were folded into other constants";
+out:
+    free(b);
+    if (!err)
+        return true;
+    fprintf(stderr, "Cannot patch kernel image: %s\n", err);
+    image_patch_free(p);
+    return false;
+}
+
+/*
+ * Returns false if the compiler could encode these values differently from
+ * the sentinels, in which case the patched image would be wrong: inline
+ * constants (0, 1, -1, 0.5 and 1.0, possibly negated) are not stored as
+ * literals, and equal values may share a literal slot.
+ */
+bool image_patch_values_ok(const uint32_t *values, int nr_values)
+{
+    static const uint32_t inline_consts[] = {
+        0x00000000, 0x00000001, 0xffffffff,
+        0x3f000000, 0x3f800000, 0xbf000000, 0xbf800000,
+    };
+    for (int i = 0; i < nr_values; i++)
+      {
+        for (unsigned c = 0; c < sizeof (inline_consts) / sizeof (*inline_consts); c++)
+            if (values[i] == inline_consts[c])
+                return false;
+        for (int j = 0; j < i; j++)
+            if (values[i] == values[j])
+                return false;
+      }
+    return true;
+}
+
+/*
+ * Returns a new image (free it with calImageFree) with these values stamped
+ * at the sites located by image_patch_init.
+ */
+CALimage image_patch_apply(const image_patch_t *p, const uint32_t *values)
+{
+    CALimage img;
+    uint8_t *bytes = malloc(p->size);
+    if (!bytes)
+        perror("malloc"), exit(1);
+    memcpy(bytes, p->bytes, p->size);
+    for (int i = 0; i < p->nr_sites; i++)
+        memcpy(bytes + p->sites[i].offset, values + p->sites[i].idx, 4);
+    if (CAL_RESULT_OK != calImageRead(&img, bytes, p->size))
+        fatal("calImageRead");
+    free(bytes);
+    return img;
+}
+
+void image_patch_free(image_patch_t *p)
+{
+    free(p->bytes);
+    free(p->sites);
+    p->bytes = NULL;
+    p->sites = NULL;
+    p->nr_sites = 0;
+}
+
+/*
+ * Compares the serialized images, and reports the first difference.
+ */
+bool image_equal(CALimage a, CALimage b)
+{
+    CALuint size_a, size_b;
+    uint8_t *ba = image_bytes(a, &size_a);
+    uint8_t *bb = image_bytes(b, &size_b);
+    bool equal = size_a == size_b && !memcmp(ba, bb, size_a);
+    if (size_a != size_b)
+        fprintf(stderr, "Image sizes differ: %u and %u bytes\n",
+                size_a, size_b);
+    else if (!equal)
+      {
+        CALuint off = 0;
+        while (ba[off] == bb[off])
+            off++;
+        fprintf(stderr, "Images differ at offset 0x%x\n", off);
+      }
+    free(ba);
+    free(bb);
+    return equal;
 }
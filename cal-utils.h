@@ -8,9 +8,70 @@
 #define OP3_INST_BIT_ALIGN_INT	12UL
 #define OP3_INST_BYTE_ALIGN_INT	13UL
 
+/*
+ * Control flow program and ALU clause encodings, from the same PDF.
+ */
+#define CF_ALU_BIT		(1U << 29) // in CF_ALU_WORD1 (CF_INST 8-15)
+#define CF_INST_ALU_EXTENDED	12U	   // CF_INST of CF_ALU_WORD1
+#define CF_END_OF_PROGRAM_BIT	(1U << 21) // in CF_WORD1
+#define CF_INST_TC		1U	   // CF_INST of CF_WORD1
+#define CF_INST_VC		2U
+#define CF_INST_END		32U	   // Cayman, which has no END_OF_PROGRAM
+#define ALU_SRC_LITERAL		253	   // SRC*_SEL of a literal constant
+
+// name of the notes of CAL ELF objects and images
+#define CAL_NOTE_NAME		"ATI CAL"
+
+typedef struct
+{
+    uint32_t	size;		// of the whole ELF file
+    uint32_t	text_off;	// ISA of the first encoding
+    uint32_t	text_size;
+    int		nr_notes;
+} cal_elf_t;
+
+typedef struct
+{
+    int		groups;
+    int		slots;
+    int		literals;
+    int		bfe_int;
+    int		bfe_uint;
+    int		bit_align;
+    int		byte_align;
+} alu_stats_t;
+
 void fatal(const char *func_name);
 void show_ver(void);
 const char *target_name(CALtarget target, CALuint revision);
 void display_attribs(CALdeviceattribs *a);
+bool cal_elf_parse(const uint8_t *buf, uint32_t max_size, cal_elf_t *elf);
+int walk_alu_clauses(int verbose, uint8_t *text, uint32_t text_size,
+        bool dry_run, alu_stats_t *total);
 void patch_bfi_int_instructions(int verbose, CALobject *obj,
-        unsigned bytes_to_scan, int expected_min, int expected_max);
+        unsigned max_size, int expected_min, int expected_max);
+void save_cal_object(const char *path, CALobject *obj, unsigned max_size);
+void analyze_cal_object(int verbose, const char *path);
+
+/*
+ * A serialized image and the offsets where literals of the kernel landed, so
+ * that new literal values can be stamped in without recompiling.
+ */
+typedef struct
+{
+    uint8_t	*bytes;
+    CALuint	size;
+    int		nr_sites;
+    struct literal_site
+      {
+        CALuint	offset;
+        int	idx; // of the value stored there
+      }		*sites;
+} image_patch_t;
+
+bool image_patch_init(image_patch_t *p, CALimage img_a, CALimage img_b,
+        const uint32_t *values_a, const uint32_t *values_b, int nr_values);
+bool image_patch_values_ok(const uint32_t *values, int nr_values);
+CALimage image_patch_apply(const image_patch_t *p, const uint32_t *values);
+void image_patch_free(image_patch_t *p);
+bool image_equal(CALimage a, CALimage b);
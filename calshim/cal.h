@@ -0,0 +1,155 @@
+/*
+ * Software stand-in for the CAL runtime (libaticalrt), limited to what
+ * hdminer uses. Build with "make SHIM=1" to link hdminer against it instead
+ * of the AMD SDK. See calshim.c for the devices it emulates.
+ */
+
+#ifndef CAL_H
+#define CAL_H
+
+// lets callers skip what only makes sense with the real runtime
+#define CALSHIM	1
+
+typedef void		CALvoid;
+typedef char		CALchar;
+typedef int		CALint;
+typedef unsigned int	CALuint;
+typedef CALuint		CALboolean;
+
+typedef enum
+{
+    CAL_RESULT_OK = 0,
+    CAL_RESULT_ERROR = 1,
+    CAL_RESULT_INVALID_PARAMETER = 2,
+    CAL_RESULT_NOT_SUPPORTED = 3,
+    CAL_RESULT_ALREADY = 4,
+    CAL_RESULT_NOT_INITIALIZED = 5,
+    CAL_RESULT_BAD_HANDLE = 6,
+    CAL_RESULT_BAD_NAME_TYPE = 7,
+    CAL_RESULT_PENDING = 8,
+    CAL_RESULT_BUSY = 9,
+    CAL_RESULT_WARNING = 10,
+}		CALresult;
+
+typedef enum
+{
+    CAL_TARGET_600,
+    CAL_TARGET_610,
+    CAL_TARGET_630,
+    CAL_TARGET_670,
+    CAL_TARGET_7XX,
+    CAL_TARGET_770,
+    CAL_TARGET_710,
+    CAL_TARGET_730,
+    CAL_TARGET_CYPRESS,
+    CAL_TARGET_JUNIPER,
+    CAL_TARGET_REDWOOD,
+    CAL_TARGET_CEDAR,
+}		CALtarget;
+
+typedef enum
+{
+    CAL_FORMAT_UNORM_INT32_1 = 9,
+}		CALformat;
+
+typedef enum
+{
+    CAL_RESALLOC_GLOBAL_BUFFER = 1,
+    CAL_RESALLOC_CACHEABLE = 2,
+}		CALresallocflags;
+
+typedef struct CALimageRec	*CALimage;
+typedef CALuint			CALdevice;
+typedef CALuint			CALcontext;
+typedef CALuint			CALresource;
+typedef CALuint			CALmem;
+typedef CALuint			CALfunc;
+typedef CALuint			CALname;
+typedef CALuint			CALmodule;
+typedef CALuint			CALevent;
+
+typedef struct
+{
+    CALuint	width;
+    CALuint	height;
+    CALuint	depth;
+}		CALdomain3D;
+
+typedef struct
+{
+    CALfunc	func;
+    CALdomain3D	gridBlock;
+    CALdomain3D	gridSize;
+    CALuint	flags;
+}		CALprogramGrid;
+
+typedef struct
+{
+    CALuint	struct_size;
+    CALtarget	target;
+    CALuint	localRAM;
+    CALuint	uncachedRemoteRAM;
+    CALuint	cachedRemoteRAM;
+    CALuint	engineClock;
+    CALuint	memoryClock;
+    CALuint	wavefrontSize;
+    CALuint	numberOfSIMD;
+    CALboolean	doublePrecision;
+    CALboolean	localDataShare;
+    CALboolean	globalDataShare;
+    CALboolean	globalGPR;
+    CALboolean	computeShader;
+    CALboolean	memExport;
+    CALuint	pitch_alignment;
+    CALuint	surface_alignment;
+    CALuint	numberOfUAVs;
+    CALboolean	bUAVMemExport;
+    CALboolean	b3dProgramGrid;
+    CALuint	numberOfShaderEngines;
+    CALuint	targetRevision;
+}		CALdeviceattribs;
+
+CALresult calInit(void);
+CALresult calShutdown(void);
+CALresult calGetVersion(CALuint *major, CALuint *minor, CALuint *imp);
+const CALchar *calGetErrorString(void);
+
+CALresult calDeviceGetCount(CALuint *count);
+CALresult calDeviceGetAttribs(CALdeviceattribs *attribs, CALuint ordinal);
+CALresult calDeviceOpen(CALdevice *dev, CALuint ordinal);
+CALresult calDeviceClose(CALdevice dev);
+
+CALresult calCtxCreate(CALcontext *ctx, CALdevice dev);
+CALresult calCtxDestroy(CALcontext ctx);
+
+CALresult calResAllocLocal1D(CALresource *res, CALdevice dev, CALuint width,
+        CALformat format, CALuint flags);
+CALresult calResAllocRemote1D(CALresource *res, CALdevice *dev,
+        CALuint nr_devs, CALuint width, CALformat format, CALuint flags);
+CALresult calResFree(CALresource res);
+CALresult calResMap(CALvoid **ptr, CALuint *pitch, CALresource res,
+        CALuint flags);
+CALresult calResUnmap(CALresource res);
+
+CALresult calCtxGetMem(CALmem *mem, CALcontext ctx, CALresource res);
+CALresult calCtxReleaseMem(CALcontext ctx, CALmem mem);
+CALresult calCtxSetMem(CALcontext ctx, CALname name, CALmem mem);
+
+CALresult calImageRead(CALimage *img, const CALvoid *buf, CALuint size);
+CALresult calImageFree(CALimage img);
+
+CALresult calModuleLoad(CALmodule *module, CALcontext ctx, CALimage img);
+CALresult calModuleUnload(CALcontext ctx, CALmodule module);
+CALresult calModuleGetEntry(CALfunc *func, CALcontext ctx, CALmodule module,
+        const CALchar *name);
+CALresult calModuleGetName(CALname *name, CALcontext ctx, CALmodule module,
+        const CALchar *var_name);
+
+CALresult calCtxRunProgramGrid(CALevent *event, CALcontext ctx,
+        CALprogramGrid *grid);
+CALresult calCtxIsEventDone(CALcontext ctx, CALevent event);
+CALresult calCtxWaitForEvents(CALcontext ctx, CALevent *events, CALuint nr,
+        CALuint flags);
+CALresult calCtxFlush(CALcontext ctx);
+
+#endif
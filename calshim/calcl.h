@@ -0,0 +1,30 @@
+/*
+ * Software stand-in for the CAL compiler (libaticalcl), see cal.h. Objects
+ * and images hold the IL source: compiling only checks what the emulated
+ * devices need from it.
+ */
+
+#ifndef CALCL_H
+#define CALCL_H
+
+#include "cal.h"
+
+typedef enum
+{
+    CAL_LANGUAGE_IL = 1,
+}		CALlanguage;
+
+typedef struct CALobjectRec	*CALobject;
+typedef void (*CALLogFunction)(const CALchar *msg);
+
+CALresult calclCompile(CALobject *obj, CALlanguage lang,
+        const CALchar *source, CALtarget target);
+CALresult calclLink(CALimage *img, CALobject *obj, CALuint nr_objs);
+CALresult calclFreeObject(CALobject obj);
+CALresult calclFreeImage(CALimage img);
+CALresult calclImageGetSize(CALuint *size, CALimage img);
+CALresult calclImageWrite(CALvoid *buf, CALuint size, CALimage img);
+void calclDisassembleImage(const CALimage img, CALLogFunction log);
+const CALchar *calclGetErrorString(void);
+
+#endif
@@ -0,0 +1,738 @@
+#define _POSIX_C_SOURCE 200809L
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "cal.h"
+#include "calcl.h"
+#include "calshim.h"
+
+/*
+ * Software CAL runtime: N virtual devices backed by host memory, each context
+ * running its programs in order on a worker thread. A run applies the kernel
+ * model (kernel-model.c) to the memories bound to the module, then completes
+ * once the time the device would have taken has elapsed:
+ *
+ *   latency + hashes / (SIMDs * rate per SIMD)
+ *
+ * Configured from the environment when calInit is called. Each variable is a
+ * comma-separated list of values, device i taking value i modulo its length:
+ *
+ *   CALSHIM_DEVICES     number of devices (a single value, default 1)
+ *   CALSHIM_SIMDS       SIMDs of each device (default 20, as a HD 5870)
+ *   CALSHIM_MHASH       Mhash/sec per SIMD, 0 to complete runs right away
+ *                       (default 17, as a HD 5870)
+ *   CALSHIM_LATENCY_US  fixed cost of each run in microseconds (default 50)
+ *   CALSHIM_REMOTE_MB   uncached and cached remote RAM, 0 for none, when
+ *                       calResAllocRemote1D fails (default 256)
+ */
+
+#define SHIM_MAGIC	"CALSHIM IL 1\n"
+
+typedef struct
+{
+    CALuint	simds;
+    double	mhash;		// per SIMD
+    double	latency;	// seconds
+    CALuint	remote;		// MB of remote RAM of each kind
+}		shim_device_t;
+
+typedef struct
+{
+    void	*data;
+    CALuint	size;
+}		shim_res_t;
+
+typedef struct
+{
+    shim_res_t	*res;
+}		shim_mem_t;
+
+struct shim_name;
+
+typedef struct
+{
+    shim_kernel_t	k;
+    struct shim_name	*names[SHIM_NR_NAMES];
+    CALname		name_handles[SHIM_NR_NAMES];
+}		shim_module_t;
+
+typedef struct shim_name
+{
+    int		kind;
+    shim_mem_t	*mem; // bound with calCtxSetMem
+}		shim_name_t;
+
+typedef struct shim_run
+{
+    const shim_kernel_t	*k; // the module must outlive its runs
+    CALuint		nr_threads;
+    shim_bufs_t		bufs;
+    CALevent		event;
+    struct shim_run	*next;
+}		shim_run_t;
+
+typedef struct
+{
+    const shim_device_t	*dev;
+    pthread_t		thread;
+    pthread_mutex_t	lock;
+    pthread_cond_t	cond;		// a run was queued or completed
+    shim_run_t		*head;		// queued runs, the first one running
+    shim_run_t		*tail;
+    CALevent		last_event;	// of the last run queued
+    CALevent		done_event;	// runs completed up to this one
+    bool		quit;
+}		shim_ctx_t;
+
+struct CALobjectRec
+{
+    char	*src;
+};
+
+struct CALimageRec
+{
+    char		*src;
+    shim_kernel_t	k;
+};
+
+/*
+ * Handles of all the objects: index + 1 in a table where freed entries are
+ * reused.
+ */
+enum { H_FREE, H_DEVICE, H_CTX, H_RES, H_MEM, H_MODULE, H_NAME };
+typedef struct
+{
+    int		type;
+    void	*p;
+}		shim_handle_t;
+
+static shim_handle_t *handles;
+static CALuint nr_handles;
+static pthread_mutex_t handles_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static shim_device_t *devices;
+static CALuint nr_devices;
+static const char *cal_error = "";
+static const char *calcl_error = "";
+
+static CALresult fail(CALresult res, const char *msg)
+{
+    cal_error = msg;
+    return res;
+}
+
+static CALuint handle_new(int type, void *p)
+{
+    CALuint h;
+    pthread_mutex_lock(&handles_lock);
+    for (h = 0; h < nr_handles; h++)
+        if (handles[h].type == H_FREE)
+            break;
+    if (h == nr_handles)
+      {
+        nr_handles = nr_handles ? 2 * nr_handles : 64;
+        handles = realloc(handles, nr_handles * sizeof (*handles));
+        if (!handles)
+            perror("realloc"), exit(1);
+        memset(handles + h, 0, (nr_handles - h) * sizeof (*handles));
+      }
+    handles[h].type = type;
+    handles[h].p = p;
+    pthread_mutex_unlock(&handles_lock);
+    return h + 1;
+}
+
+static void *handle_get(CALuint h, int type)
+{
+    void *p = NULL;
+    pthread_mutex_lock(&handles_lock);
+    if (h && h <= nr_handles && handles[h - 1].type == type)
+        p = handles[h - 1].p;
+    pthread_mutex_unlock(&handles_lock);
+    return p;
+}
+
+static void handle_free(CALuint h)
+{
+    pthread_mutex_lock(&handles_lock);
+    handles[h - 1].type = H_FREE;
+    handles[h - 1].p = NULL;
+    pthread_mutex_unlock(&handles_lock);
+}
+
+/*
+ * Value i (modulo their number) of the comma-separated list in environment
+ * variable name, or def if it is not set.
+ */
+static double env_value(const char *name, CALuint i, double def)
+{
+    const char *s = getenv(name);
+    int n = 0;
+    if (!s || !*s)
+        return def;
+    for (const char *c = s; *c; c++)
+        n += *c == ',';
+    i %= n + 1;
+    while (i--)
+        s = strchr(s, ',') + 1;
+    return strtod(s, NULL);
+}
+
+CALresult calInit(void)
+{
+    if (devices)
+        return fail(CAL_RESULT_ALREADY, "already initialized");
+    nr_devices = env_value("CALSHIM_DEVICES", 0, 1);
+    if (!(devices = calloc(nr_devices ? nr_devices : 1, sizeof (*devices))))
+        perror("calloc"), exit(1);
+    for (CALuint i = 0; i < nr_devices; i++)
+      {
+        devices[i].simds = env_value("CALSHIM_SIMDS", i, 20);
+        devices[i].mhash = env_value("CALSHIM_MHASH", i, 17);
+        devices[i].latency = env_value("CALSHIM_LATENCY_US", i, 50) / 1e6;
+        devices[i].remote = env_value("CALSHIM_REMOTE_MB", i, 256);
+        if (!devices[i].simds)
+            devices[i].simds = 1;
+      }
+    return CAL_RESULT_OK;
+}
+
+CALresult calShutdown(void)
+{
+    free(devices);
+    devices = NULL;
+    nr_devices = 0;
+    return CAL_RESULT_OK;
+}
+
+CALresult calGetVersion(CALuint *major, CALuint *minor, CALuint *imp)
+{
+    // not a version of the real runtime, so that their images are not mixed
+    *major = 0;
+    *minor = 1;
+    *imp = 0;
+    return CAL_RESULT_OK;
+}
+
+const CALchar *calGetErrorString(void)
+{
+    return cal_error;
+}
+
+CALresult calDeviceGetCount(CALuint *count)
+{
+    if (!devices)
+        return fail(CAL_RESULT_NOT_INITIALIZED, "calInit not called");
+    *count = nr_devices;
+    return CAL_RESULT_OK;
+}
+
+CALresult calDeviceGetAttribs(CALdeviceattribs *attribs, CALuint ordinal)
+{
+    if (ordinal >= nr_devices)
+        return fail(CAL_RESULT_INVALID_PARAMETER, "no such device");
+    const shim_device_t *d = devices + ordinal;
+    CALuint size = attribs->struct_size;
+    memset(attribs, 0, sizeof (*attribs));
+    attribs->struct_size = size;
+    attribs->target = CAL_TARGET_CYPRESS;
+    attribs->localRAM = 1024;
+    attribs->uncachedRemoteRAM = d->remote;
+    attribs->cachedRemoteRAM = d->remote;
+    attribs->engineClock = 850;
+    attribs->memoryClock = 1200;
+    attribs->wavefrontSize = 64;
+    attribs->numberOfSIMD = d->simds;
+    attribs->computeShader = 1;
+    attribs->memExport = 1;
+    attribs->numberOfUAVs = 12;
+    attribs->bUAVMemExport = 1;
+    attribs->numberOfShaderEngines = 1;
+    return CAL_RESULT_OK;
+}
+
+CALresult calDeviceOpen(CALdevice *dev, CALuint ordinal)
+{
+    if (ordinal >= nr_devices)
+        return fail(CAL_RESULT_INVALID_PARAMETER, "no such device");
+    *dev = handle_new(H_DEVICE, devices + ordinal);
+    return CAL_RESULT_OK;
+}
+
+CALresult calDeviceClose(CALdevice dev)
+{
+    if (!handle_get(dev, H_DEVICE))
+        return fail(CAL_RESULT_BAD_HANDLE, "bad device");
+    handle_free(dev);
+    return CAL_RESULT_OK;
+}
+
+static void sleep_until(const struct timespec *t)
+{
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, t, NULL))
+        ;
+}
+
+/*
+ * Worker thread of a context: runs its queued programs in order.
+ */
+static void *ctx_thread(void *arg)
+{
+    shim_ctx_t *c = arg;
+    pthread_mutex_lock(&c->lock);
+    for (;;)
+      {
+        while (!c->head && !c->quit)
+            pthread_cond_wait(&c->cond, &c->lock);
+        if (c->quit)
+            break;
+        shim_run_t *r = c->head;
+        pthread_mutex_unlock(&c->lock);
+        struct timespec end;
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        uint64_t hashes = shim_kernel_run(r->k, r->nr_threads, &r->bufs);
+        double t = c->dev->latency;
+        if (c->dev->mhash > 0)
+            t += hashes / (c->dev->simds * c->dev->mhash * 1e6);
+        end.tv_sec += (time_t)t;
+        end.tv_nsec += (t - (time_t)t) * 1e9;
+        if (end.tv_nsec >= 1000000000)
+          {
+            end.tv_sec++;
+            end.tv_nsec -= 1000000000;
+          }
+        sleep_until(&end);
+        pthread_mutex_lock(&c->lock);
+        c->head = r->next;
+        if (!c->head)
+            c->tail = NULL;
+        c->done_event = r->event;
+        pthread_cond_broadcast(&c->cond);
+        free(r);
+      }
+    pthread_mutex_unlock(&c->lock);
+    return NULL;
+}
+
+CALresult calCtxCreate(CALcontext *ctx, CALdevice dev)
+{
+    const shim_device_t *d = handle_get(dev, H_DEVICE);
+    if (!d)
+        return fail(CAL_RESULT_BAD_HANDLE, "bad device");
+    shim_ctx_t *c = calloc(1, sizeof (*c));
+    if (!c)
+        perror("calloc"), exit(1);
+    c->dev = d;
+    pthread_mutex_init(&c->lock, NULL);
+    pthread_cond_init(&c->cond, NULL);
+    if (pthread_create(&c->thread, NULL, ctx_thread, c))
+        perror("pthread_create"), exit(1);
+    *ctx = handle_new(H_CTX, c);
+    return CAL_RESULT_OK;
+}
+
+CALresult calCtxDestroy(CALcontext ctx)
+{
+    shim_ctx_t *c = handle_get(ctx, H_CTX);
+    if (!c)
+        return fail(CAL_RESULT_BAD_HANDLE, "bad context");
+    pthread_mutex_lock(&c->lock);
+    c->quit = true;
+    pthread_cond_broadcast(&c->cond);
+    pthread_mutex_unlock(&c->lock);
+    pthread_join(c->thread, NULL);
+    while (c->head)
+      {
+        shim_run_t *r = c->head;
+        c->head = r->next;
+        free(r);
+      }
+    pthread_cond_destroy(&c->cond);
+    pthread_mutex_destroy(&c->lock);
+    handle_free(ctx);
+    free(c);
+    return CAL_RESULT_OK;
+}
+
+static CALresult res_alloc(CALresource *res, CALuint width, CALformat format)
+{
+    if (format != CAL_FORMAT_UNORM_INT32_1)
+        return fail(CAL_RESULT_NOT_SUPPORTED, "unsupported format");
+    shim_res_t *r = calloc(1, sizeof (*r));
+    if (!r || !(r->data = calloc(width, 4)))
+        perror("calloc"), exit(1);
+    r->size = width * 4;
+    *res = handle_new(H_RES, r);
+    return CAL_RESULT_OK;
+}
+
+CALresult calResAllocLocal1D(CALresource *res, CALdevice dev, CALuint width,
+        CALformat format, CALuint flags)
+{
+    (void)flags;
+    if (!handle_get(dev, H_DEVICE))
+        return fail(CAL_RESULT_BAD_HANDLE, "bad device");
+    return res_alloc(res, width, format);
+}
+
+CALresult calResAllocRemote1D(CALresource *res, CALdevice *dev,
+        CALuint nr_devs, CALuint width, CALformat format, CALuint flags)
+{
+    (void)flags;
+    for (CALuint i = 0; i < nr_devs; i++)
+      {
+        const shim_device_t *d = handle_get(dev[i], H_DEVICE);
+        if (!d)
+            return fail(CAL_RESULT_BAD_HANDLE, "bad device");
+        if (width * 4ULL > d->remote * 1048576ULL)
+            return fail(CAL_RESULT_ERROR, "out of remote RAM");
+      }
+    return res_alloc(res, width, format);
+}
+
+CALresult calResFree(CALresource res)
+{
+    shim_res_t *r = handle_get(res, H_RES);
+    if (!r)
+        return fail(CAL_RESULT_BAD_HANDLE, "bad resource");
+    handle_free(res);
+    free(r->data);
+    free(r);
+    return CAL_RESULT_OK;
+}
+
+CALresult calResMap(CALvoid **ptr, CALuint *pitch, CALresource res,
+        CALuint flags)
+{
+    shim_res_t *r = handle_get(res, H_RES);
+    (void)flags;
+    if (!r)
+        return fail(CAL_RESULT_BAD_HANDLE, "bad resource");
+    *ptr = r->data;
+    *pitch = r->size / 4;
+    return CAL_RESULT_OK;
+}
+
+CALresult calResUnmap(CALresource res)
+{
+    if (!handle_get(res, H_RES))
+        return fail(CAL_RESULT_BAD_HANDLE, "bad resource");
+    return CAL_RESULT_OK;
+}
+
+CALresult calCtxGetMem(CALmem *mem, CALcontext ctx, CALresource res)
+{
+    shim_mem_t *m;
+    if (!handle_get(ctx, H_CTX))
+        return fail(CAL_RESULT_BAD_HANDLE, "bad context");
+    shim_res_t *r = handle_get(res, H_RES);
+    if (!r)
+        return fail(CAL_RESULT_BAD_HANDLE, "bad resource");
+    if (!(m = malloc(sizeof (*m))))
+        perror("malloc"), exit(1);
+    m->res = r;
+    *mem = handle_new(H_MEM, m);
+    return CAL_RESULT_OK;
+}
+
+CALresult calCtxReleaseMem(CALcontext ctx, CALmem mem)
+{
+    shim_mem_t *m = handle_get(mem, H_MEM);
+    if (!handle_get(ctx, H_CTX) || !m)
+        return fail(CAL_RESULT_BAD_HANDLE, "bad context or memory");
+    handle_free(mem);
+    free(m);
+    return CAL_RESULT_OK;
+}
+
+CALresult calCtxSetMem(CALcontext ctx, CALname name, CALmem mem)
+{
+    shim_name_t *n = handle_get(name, H_NAME);
+    shim_mem_t *m = handle_get(mem, H_MEM);
+    if (!handle_get(ctx, H_CTX) || !n || !m)
+        return fail(CAL_RESULT_BAD_HANDLE, "bad context, name or memory");
+    n->mem = m;
+    return CAL_RESULT_OK;
+}
+
+/*
+ * Fills k from the declarations of the IL src. Returns false, with the
+ * reason in calcl_error, if the devices cannot run it.
+ */
+static bool parse_kernel(shim_kernel_t *k, const char *src)
+{
+    const char *err = NULL;
+    memset(k, 0, sizeof (*k));
+    if (strncmp(src, "il_cs", 5))
+      {
+        calcl_error = "not a compute shader (il_cs)";
+        return false;
+      }
+    for (const char *l = src; l; l = strchr(l, '\n'), l = l ? l + 1 : l)
+      {
+        unsigned i;
+        long long v[4];
+        while (*l == ' ' || *l == '\t')
+            l++;
+        if (1 == sscanf(l, "dcl_num_thread_per_group %u", &k->threads_per_grp))
+            continue;
+        if (!strncmp(l, "dcl_raw_uav_id(1)", 17))
+            k->uav1 = true;
+        else if (5 == sscanf(l, "dcl_literal l%u , %lli , %lli , %lli , %lli",
+                    &i, &v[0], &v[1], &v[2], &v[3]) && i < SHIM_NR_LITERALS)
+          {
+            for (int c = 0; c < 4; c++)
+                k->lit[i][c] = v[c];
+            k->has_lit[i] = true;
+          }
+      }
+    if (!shim_kernel_check(k, &err))
+      {
+        calcl_error = err;
+        return false;
+      }
+    return true;
+}
+
+CALresult calclCompile(CALobject *obj, CALlanguage lang,
+        const CALchar *source, CALtarget target)
+{
+    shim_kernel_t k;
+    (void)target;
+    if (lang != CAL_LANGUAGE_IL)
+        return fail(CAL_RESULT_NOT_SUPPORTED, "only IL is supported");
+    if (!parse_kernel(&k, source))
+        return fail(CAL_RESULT_ERROR, "compilation failed");
+    if (!(*obj = malloc(sizeof (**obj))) || !((*obj)->src = strdup(source)))
+        perror("malloc"), exit(1);
+    return CAL_RESULT_OK;
+}
+
+CALresult calclFreeObject(CALobject obj)
+{
+    free(obj->src);
+    free(obj);
+    return CAL_RESULT_OK;
+}
+
+static CALimage image_new(const char *src)
+{
+    CALimage img = malloc(sizeof (*img));
+    if (!img || !(img->src = strdup(src)))
+        perror("malloc"), exit(1);
+    if (!parse_kernel(&img->k, src))
+      {
+        free(img->src);
+        free(img);
+        return NULL;
+      }
+    return img;
+}
+
+CALresult calclLink(CALimage *img, CALobject *obj, CALuint nr_objs)
+{
+    if (nr_objs != 1)
+        return fail(CAL_RESULT_NOT_SUPPORTED, "only one object is supported");
+    if (!(*img = image_new(obj[0]->src)))
+        return fail(CAL_RESULT_ERROR, "link failed");
+    return CAL_RESULT_OK;
+}
+
+CALresult calImageFree(CALimage img)
+{
+    free(img->src);
+    free(img);
+    return CAL_RESULT_OK;
+}
+
+CALresult calclFreeImage(CALimage img)
+{
+    return calImageFree(img);
+}
+
+/*
+ * Serialized images are the IL after a magic line.
+ */
+CALresult calclImageGetSize(CALuint *size, CALimage img)
+{
+    *size = strlen(SHIM_MAGIC) + strlen(img->src);
+    return CAL_RESULT_OK;
+}
+
+CALresult calclImageWrite(CALvoid *buf, CALuint size, CALimage img)
+{
+    CALuint needed;
+    calclImageGetSize(&needed, img);
+    if (size < needed)
+        return fail(CAL_RESULT_INVALID_PARAMETER, "buffer too small");
+    memcpy(buf, SHIM_MAGIC, strlen(SHIM_MAGIC));
+    memcpy((char *)buf + strlen(SHIM_MAGIC), img->src, strlen(img->src));
+    return CAL_RESULT_OK;
+}
+
+CALresult calImageRead(CALimage *img, const CALvoid *buf, CALuint size)
+{
+    const size_t len = strlen(SHIM_MAGIC);
+    if (size < len || memcmp(buf, SHIM_MAGIC, len))
+        return fail(CAL_RESULT_ERROR, "not an image of the shim");
+    char *src = malloc(size - len + 1);
+    if (!src)
+        perror("malloc"), exit(1);
+    memcpy(src, (const char *)buf + len, size - len);
+    src[size - len] = 0;
+    *img = image_new(src);
+    free(src);
+    if (!*img)
+        return fail(CAL_RESULT_ERROR, "bad image");
+    return CAL_RESULT_OK;
+}
+
+void calclDisassembleImage(const CALimage img, CALLogFunction log)
+{
+    log(img->src);
+}
+
+const CALchar *calclGetErrorString(void)
+{
+    return calcl_error;
+}
+
+CALresult calModuleLoad(CALmodule *module, CALcontext ctx, CALimage img)
+{
+    if (!handle_get(ctx, H_CTX))
+        return fail(CAL_RESULT_BAD_HANDLE, "bad context");
+    shim_module_t *m = calloc(1, sizeof (*m));
+    if (!m)
+        perror("calloc"), exit(1);
+    m->k = img->k;
+    *module = handle_new(H_MODULE, m);
+    return CAL_RESULT_OK;
+}
+
+CALresult calModuleUnload(CALcontext ctx, CALmodule module)
+{
+    shim_module_t *m = handle_get(module, H_MODULE);
+    if (!handle_get(ctx, H_CTX) || !m)
+        return fail(CAL_RESULT_BAD_HANDLE, "bad context or module");
+    for (int i = 0; i < SHIM_NR_NAMES; i++)
+        if (m->names[i])
+          {
+            handle_free(m->name_handles[i]);
+            free(m->names[i]);
+          }
+    handle_free(module);
+    free(m);
+    return CAL_RESULT_OK;
+}
+
+CALresult calModuleGetEntry(CALfunc *func, CALcontext ctx, CALmodule module,
+        const CALchar *name)
+{
+    if (!handle_get(ctx, H_CTX) || !handle_get(module, H_MODULE))
+        return fail(CAL_RESULT_BAD_HANDLE, "bad context or module");
+    if (strcmp(name, "main"))
+        return fail(CAL_RESULT_INVALID_PARAMETER, "no such entry point");
+    // the function of a module is the module
+    *func = module;
+    return CAL_RESULT_OK;
+}
+
+CALresult calModuleGetName(CALname *name, CALcontext ctx, CALmodule module,
+        const CALchar *var_name)
+{
+    static const char *names[SHIM_NR_NAMES] = { "g[]", "uav1", "cb0", "cb1" };
+    shim_module_t *m = handle_get(module, H_MODULE);
+    int i;
+    if (!handle_get(ctx, H_CTX) || !m)
+        return fail(CAL_RESULT_BAD_HANDLE, "bad context or module");
+    for (i = 0; i < SHIM_NR_NAMES; i++)
+        if (!strcmp(var_name, names[i]))
+            break;
+    if (i == SHIM_NR_NAMES || (i == SHIM_UAV1 && !m->k.uav1))
+        return fail(CAL_RESULT_INVALID_PARAMETER, "no such name");
+    if (!m->names[i])
+      {
+        if (!(m->names[i] = calloc(1, sizeof (*m->names[i]))))
+            perror("calloc"), exit(1);
+        m->names[i]->kind = i;
+        m->name_handles[i] = handle_new(H_NAME, m->names[i]);
+      }
+    *name = m->name_handles[i];
+    return CAL_RESULT_OK;
+}
+
+CALresult calCtxRunProgramGrid(CALevent *event, CALcontext ctx,
+        CALprogramGrid *grid)
+{
+    shim_ctx_t *c = handle_get(ctx, H_CTX);
+    shim_module_t *m = handle_get(grid->func, H_MODULE);
+    if (!c || !m)
+        return fail(CAL_RESULT_BAD_HANDLE, "bad context or function");
+    if (grid->gridBlock.width != m->k.threads_per_grp ||
+            grid->gridBlock.height > 1 || grid->gridBlock.depth > 1)
+        return fail(CAL_RESULT_INVALID_PARAMETER,
+                "group size is not dcl_num_thread_per_group");
+    shim_run_t *r = calloc(1, sizeof (*r));
+    if (!r)
+        perror("calloc"), exit(1);
+    r->k = &m->k;
+    r->nr_threads = grid->gridBlock.width * grid->gridSize.width *
+        (grid->gridSize.height ? grid->gridSize.height : 1) *
+        (grid->gridSize.depth ? grid->gridSize.depth : 1);
+    // the memories bound now, later calCtxSetMem do not affect this run
+    for (int i = 0; i < SHIM_NR_NAMES; i++)
+        if (m->names[i] && m->names[i]->mem)
+          {
+            r->bufs.mem[i] = m->names[i]->mem->res->data;
+            r->bufs.size[i] = m->names[i]->mem->res->size;
+          }
+    pthread_mutex_lock(&c->lock);
+    r->event = *event = ++c->last_event;
+    if (c->tail)
+        c->tail->next = r;
+    else
+        c->head = r;
+    c->tail = r;
+    pthread_cond_broadcast(&c->cond);
+    pthread_mutex_unlock(&c->lock);
+    return CAL_RESULT_OK;
+}
+
+CALresult calCtxIsEventDone(CALcontext ctx, CALevent event)
+{
+    shim_ctx_t *c = handle_get(ctx, H_CTX);
+    if (!c)
+        return fail(CAL_RESULT_BAD_HANDLE, "bad context");
+    pthread_mutex_lock(&c->lock);
+    bool done = event <= c->done_event;
+    pthread_mutex_unlock(&c->lock);
+    return done ? CAL_RESULT_OK : CAL_RESULT_PENDING;
+}
+
+CALresult calCtxWaitForEvents(CALcontext ctx, CALevent *events, CALuint nr,
+        CALuint flags)
+{
+    shim_ctx_t *c = handle_get(ctx, H_CTX);
+    (void)flags;
+    if (!c)
+        return fail(CAL_RESULT_BAD_HANDLE, "bad context");
+    pthread_mutex_lock(&c->lock);
+    for (CALuint i = 0; i < nr; i++)
+        while (events[i] > c->done_event)
+            pthread_cond_wait(&c->cond, &c->lock);
+    pthread_mutex_unlock(&c->lock);
+    return CAL_RESULT_OK;
+}
+
+CALresult calCtxFlush(CALcontext ctx)
+{
+    // runs are queued to the worker thread as soon as they are issued
+    if (!handle_get(ctx, H_CTX))
+        return fail(CAL_RESULT_BAD_HANDLE, "bad context");
+    return CAL_RESULT_OK;
+}
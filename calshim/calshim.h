@@ -0,0 +1,31 @@
+/*
+ * Internals of the software CAL runtime: what it knows of a kernel, and the
+ * model of what a run of it does.
+ */
+
+#define SHIM_NR_LITERALS	16
+
+/*
+ * A kernel, from the declarations of its IL.
+ */
+typedef struct
+{
+    CALuint	threads_per_grp;	// dcl_num_thread_per_group
+    uint32_t	lit[SHIM_NR_LITERALS][4]; // dcl_literal l0-l15
+    bool	has_lit[SHIM_NR_LITERALS];
+    bool	uav1;			// dcl_raw_uav_id(1)
+}		shim_kernel_t;
+
+/*
+ * Memories bound to the names of a module, as captured by a run.
+ */
+enum { SHIM_G, SHIM_UAV1, SHIM_CB0, SHIM_CB1, SHIM_NR_NAMES };
+typedef struct
+{
+    uint32_t	*mem[SHIM_NR_NAMES]; // NULL if not bound
+    CALuint	size[SHIM_NR_NAMES]; // in bytes
+}		shim_bufs_t;
+
+bool shim_kernel_check(const shim_kernel_t *k, const char **err);
+uint64_t shim_kernel_run(const shim_kernel_t *k, CALuint nr_threads,
+        const shim_bufs_t *b);
@@ -0,0 +1,95 @@
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "cal.h"
+#include "calshim.h"
+
+/*
+ * Model of the kernels of kernel-sha256.pl: it is what the emulated devices
+ * run in place of the IL. Each thread advances the nonces of its elements in
+ * g[] like the kernel does, but hashes nothing, so no candidate is ever found.
+ *
+ * The layout comes from the literals of the kernel: l0.y is the size of the
+ * state of a thread in g[] (in 16-byte elements), l1.xy the values of s_found
+ * and s_finished. Element e of a thread is g[] element e of its state:
+ * status, current nonce, end nonce, and in element 0 the iterations of the
+ * run (s_found is never written, as nothing is found). A kernel declaring
+ * uav1 is a compact one: only the current nonces are written back.
+ */
+
+/*
+ * Returns false, with the reason in *err, if k is not one of these kernels.
+ */
+bool shim_kernel_check(const shim_kernel_t *k, const char **err)
+{
+    if (!k->threads_per_grp)
+        *err = "no dcl_num_thread_per_group";
+    else if (!k->has_lit[0] || !k->has_lit[1])
+        *err = "no literal l0 or l1, not an hdminer kernel";
+    else if (k->lit[0][1] < 4)
+        *err = "thread state (l0.y) smaller than 4 elements";
+    else
+        return true;
+    return false;
+}
+
+/*
+ * Runs nr_threads threads of k over the memories of b. Returns the number of
+ * hashes the device would have computed, 4 per iteration of each thread.
+ */
+uint64_t shim_kernel_run(const shim_kernel_t *k, CALuint nr_threads,
+        const shim_bufs_t *b)
+{
+    const CALuint stride = k->lit[0][1] * 4; // dwords per thread state
+    const uint32_t s_finished = k->lit[1][1];
+    uint64_t hashes = 0;
+    if (!b->mem[SHIM_G])
+        return 0;
+    for (CALuint t = 0; t < nr_threads; t++)
+      {
+        // threads past the end of g[] would write out of bounds, skip them
+        if ((uint64_t)(t + 1) * stride * 4 > b->size[SHIM_G])
+            break;
+        uint32_t *elm = b->mem[SHIM_G] + t * stride;
+        uint64_t iterations = elm[3] ? elm[3] : (uint64_t)1 << 32;
+        uint64_t loops = 0;
+        if (k->uav1)
+          {
+            // each element scans min(iterations, nonces left), the thread
+            // loops until all of them are done
+            for (int e = 0; e < 4; e++)
+              {
+                uint32_t *s = elm + 4 * e;
+                uint64_t n = (uint32_t)(s[2] - s[1]);
+                if (n > iterations)
+                    n = iterations;
+                s[1] += n;
+                if (n > loops)
+                    loops = n;
+              }
+          }
+        else
+          {
+            // the thread stops when any element reaches its end nonce (a
+            // range with cur == end is a full 2^32 one), or after iterations
+            loops = iterations;
+            for (int e = 0; e < 4; e++)
+              {
+                uint32_t *s = elm + 4 * e;
+                uint64_t n = (uint32_t)(s[2] - s[1]);
+                if (!n)
+                    n = (uint64_t)1 << 32;
+                if (n < loops)
+                    loops = n;
+              }
+            for (int e = 0; e < 4; e++)
+              {
+                uint32_t *s = elm + 4 * e;
+                s[1] += loops;
+                s[0] = s[1] == s[2] ? s_finished : 0; // s_searching
+              }
+          }
+        hashes += 4 * loops;
+      }
+    return hashes;
+}
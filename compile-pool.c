@@ -0,0 +1,157 @@
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "compile-pool.h"
+
+static bool before(const struct timespec *a, const struct timespec *b)
+{
+    return a->tv_sec < b->tv_sec ||
+        (a->tv_sec == b->tv_sec && a->tv_nsec < b->tv_nsec);
+}
+
+static void heap_push(compile_pool_t *p, const compile_job_t *job)
+{
+    compile_job_t *h = p->heap;
+    int i = p->heap_len++;
+    while (i && before(&job->deadline, &h[(i - 1) / 2].deadline))
+      {
+        h[i] = h[(i - 1) / 2];
+        i = (i - 1) / 2;
+      }
+    h[i] = *job;
+}
+
+static compile_job_t heap_pop(compile_pool_t *p)
+{
+    compile_job_t *h = p->heap, top = h[0], last = h[--p->heap_len];
+    int i = 0;
+    while (42)
+      {
+        int c = 2 * i + 1;
+        if (c >= p->heap_len)
+            break;
+        if (c + 1 < p->heap_len && before(&h[c + 1].deadline, &h[c].deadline))
+            c++;
+        if (!before(&h[c].deadline, &last.deadline))
+            break;
+        h[i] = h[c];
+        i = c;
+      }
+    h[i] = last;
+    return top;
+}
+
+static void *compile_worker(void *arg)
+{
+    compile_pool_t *p = arg;
+    pthread_mutex_lock(&p->lock);
+    while (42)
+      {
+        while (!p->heap_len && !p->quit)
+            pthread_cond_wait(&p->queued, &p->lock);
+        if (!p->heap_len)
+            break;
+        compile_job_t job = heap_pop(p);
+        p->running++;
+        pthread_mutex_unlock(&p->lock);
+        job.fn(job.arg);
+        pthread_mutex_lock(&p->lock);
+        if (!--p->running && !p->heap_len)
+            pthread_cond_broadcast(&p->idle);
+      }
+    pthread_mutex_unlock(&p->lock);
+    return NULL;
+}
+
+/*
+ * Creates one compile thread per online CPU, but at most max_workers (there
+ * is no point having more than jobs that can be pending).
+ */
+compile_pool_t *compile_pool_create(int max_workers, int verbose)
+{
+    compile_pool_t *p = calloc(1, sizeof (*p));
+    int nr_workers = sysconf(_SC_NPROCESSORS_ONLN);
+    if (!p)
+        perror("calloc"), exit(1);
+    if (nr_workers > max_workers)
+        nr_workers = max_workers;
+    if (nr_workers <= 0)
+        nr_workers = 1;
+    p->nr_workers = nr_workers;
+    p->threads = calloc(nr_workers, sizeof (*p->threads));
+    if (!p->threads)
+        perror("calloc"), exit(1);
+    pthread_mutex_init(&p->lock, NULL);
+    pthread_cond_init(&p->queued, NULL);
+    pthread_cond_init(&p->idle, NULL);
+    for (int i = 0; i < nr_workers; i++)
+        if (pthread_create(&p->threads[i], NULL, compile_worker, p))
+            perror("pthread_create"), exit(1);
+    if (verbose)
+        printf("Compiling kernels with %i thread%s\n", nr_workers,
+                nr_workers != 1 ? "s" : "");
+    return p;
+}
+
+/*
+ * Queues fn(arg), whose result is needed in lead_time seconds.
+ */
+void compile_pool_submit(compile_pool_t *p, compile_fn fn, void *arg,
+        double lead_time)
+{
+    compile_job_t job = { .fn = fn, .arg = arg };
+    clock_gettime(CLOCK_MONOTONIC, &job.deadline);
+    if (lead_time > 0)
+      {
+        long ns = (lead_time - (long)lead_time) * 1e9 + job.deadline.tv_nsec;
+        job.deadline.tv_sec += (long)lead_time + ns / 1000000000;
+        job.deadline.tv_nsec = ns % 1000000000;
+      }
+    pthread_mutex_lock(&p->lock);
+    if (p->heap_len == p->heap_max)
+      {
+        p->heap_max = p->heap_max ? 2 * p->heap_max : 16;
+        p->heap = realloc(p->heap, p->heap_max * sizeof (*p->heap));
+        if (!p->heap)
+            perror("realloc"), exit(1);
+      }
+    heap_push(p, &job);
+    pthread_cond_signal(&p->queued);
+    pthread_mutex_unlock(&p->lock);
+}
+
+/*
+ * Waits until all queued jobs are done.
+ */
+void compile_pool_wait(compile_pool_t *p)
+{
+    pthread_mutex_lock(&p->lock);
+    while (p->heap_len || p->running)
+        pthread_cond_wait(&p->idle, &p->lock);
+    pthread_mutex_unlock(&p->lock);
+}
+
+/*
+ * Runs the queued jobs, then ends the workers.
+ */
+void compile_pool_destroy(compile_pool_t *p)
+{
+    pthread_mutex_lock(&p->lock);
+    p->quit = true;
+    pthread_cond_broadcast(&p->queued);
+    pthread_mutex_unlock(&p->lock);
+    for (int i = 0; i < p->nr_workers; i++)
+        pthread_join(p->threads[i], NULL);
+    pthread_mutex_destroy(&p->lock);
+    pthread_cond_destroy(&p->queued);
+    pthread_cond_destroy(&p->idle);
+    free(p->heap);
+    free(p->threads);
+    free(p);
+}
@@ -0,0 +1,34 @@
+/*
+ * Pool of host threads compiling kernels, so that devices do not wait for
+ * each other's compilations. Queued jobs run earliest deadline first, the
+ * deadline of a job being when its device will need the result.
+ */
+
+typedef void (*compile_fn)(void *arg);
+
+typedef struct
+{
+    compile_fn		fn;
+    void		*arg;
+    struct timespec	deadline;
+}		compile_job_t;
+
+typedef struct
+{
+    int			nr_workers;
+    pthread_t		*threads;
+    pthread_mutex_t	lock;
+    pthread_cond_t	queued;		// a job was queued, or quit was set
+    pthread_cond_t	idle;		// no job queued nor running
+    compile_job_t	*heap;		// min-heap of the queued jobs on deadline
+    int			heap_len;
+    int			heap_max;
+    int			running;
+    bool		quit;
+}		compile_pool_t;
+
+compile_pool_t *compile_pool_create(int max_workers, int verbose);
+void compile_pool_submit(compile_pool_t *p, compile_fn fn, void *arg,
+        double lead_time);
+void compile_pool_wait(compile_pool_t *p);
+void compile_pool_destroy(compile_pool_t *p);
@@ -0,0 +1,234 @@
+#define _GNU_SOURCE
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "cpu-pool.h"
+
+#define CACHE_LINE	64
+
+/*
+ * Each worker has its own cache line, so that the counters one worker
+ * updates after every run are never shared with its neighbours.
+ */
+struct cpu_worker
+{
+    pthread_t		thread;
+    cpu_pool_t		*pool;
+    int			id;
+    int			cpu;		// pinned to this CPU, or -1
+    uint64_t		hashes;		// since the last cpu_pool_show_rates
+} __attribute__((aligned(CACHE_LINE)));
+
+/*
+ * Parses a comma-separated list of CPU numbers and ranges ("0-3,8").
+ */
+static void parse_cpuset(const char *str, cpu_set_t *set)
+{
+    const char *cur = str;
+    char *end;
+    CPU_ZERO(set);
+    errno = 0;
+    while (*cur)
+      {
+        long first = strtol(cur, &end, 0), last = first;
+        if (*end == '-')
+            last = strtol(end + 1, &end, 0);
+        if (errno || end == cur || first < 0 || last < first ||
+                last >= CPU_SETSIZE)
+            fprintf(stderr, "Error parsing CPU set starting from: %s\n", cur),
+                exit(1);
+        for (long n = first; n <= last; n++)
+            CPU_SET(n, set);
+        if (!*end)
+            break;
+        if (*end != ',')
+            fprintf(stderr, "CPU set does not seem to be a comma-separated "
+                    "list of integers and ranges: %s\n", cur), exit(1);
+        cur = end + 1;
+      }
+}
+
+/*
+ * Returns true iff the CPU is the first hardware thread of its core, or if
+ * the topology is unknown.
+ */
+static bool first_smt_sibling(int cpu)
+{
+    char path[128];
+    FILE *f;
+    int first;
+    snprintf(path, sizeof (path),
+            "/sys/devices/system/cpu/cpu%d/topology/thread_siblings_list", cpu);
+    if (!(f = fopen(path, "r")))
+        return true;
+    if (1 != fscanf(f, "%d", &first))
+        first = cpu;
+    fclose(f);
+    return first == cpu;
+}
+
+static void *worker_thread(void *arg)
+{
+    cpu_worker_t *w = arg;
+    cpu_pool_t *p = w->pool;
+    unsigned seen = 0;
+    pthread_mutex_lock(&p->lock);
+    for (;;)
+      {
+        while (p->generation == seen && !p->quit)
+            pthread_cond_wait(&p->start, &p->lock);
+        if (p->quit)
+            break;
+        seen = p->generation;
+        pthread_mutex_unlock(&p->lock);
+        uint64_t hashes = p->fn(p->arg, w->id);
+        pthread_mutex_lock(&p->lock);
+        w->hashes += hashes;
+        if (!--p->pending)
+            pthread_cond_broadcast(&p->done);
+      }
+    pthread_mutex_unlock(&p->lock);
+    return NULL;
+}
+
+/*
+ * Starts nr_workers threads (0 means one per selected CPU), pinned round robin
+ * to the CPUs of cpuset_str (NULL means all CPUs this process may run on),
+ * skipping the SMT siblings of each core unless use_smt is set.
+ */
+cpu_pool_t *cpu_pool_create(int nr_workers, const char *cpuset_str,
+        bool use_smt, int verbose)
+{
+    cpu_set_t allowed, wanted;
+    int cpus[CPU_SETSIZE], nr_cpus = 0;
+    cpu_pool_t *p = calloc(1, sizeof (*p));
+    if (!p)
+        perror("calloc"), exit(1);
+    if (sched_getaffinity(0, sizeof (allowed), &allowed))
+        perror("sched_getaffinity"), exit(1);
+    if (cpuset_str)
+      {
+        parse_cpuset(cpuset_str, &wanted);
+        CPU_AND(&allowed, &allowed, &wanted);
+      }
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+        if (CPU_ISSET(cpu, &allowed) && (use_smt || first_smt_sibling(cpu)))
+            cpus[nr_cpus++] = cpu;
+    if (!nr_cpus)
+        fprintf(stderr, "No CPU to run on in the CPU set\n"), exit(1);
+    p->nr_workers = nr_workers > 0 ? nr_workers : nr_cpus;
+    if (posix_memalign((void **)&p->workers, CACHE_LINE,
+                p->nr_workers * sizeof (*p->workers)))
+        perror("posix_memalign"), exit(1);
+    memset(p->workers, 0, p->nr_workers * sizeof (*p->workers));
+    pthread_mutex_init(&p->lock, NULL);
+    pthread_cond_init(&p->start, NULL);
+    pthread_cond_init(&p->done, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &p->ts_rates);
+    for (int i = 0; i < p->nr_workers; i++)
+      {
+        cpu_worker_t *w = p->workers + i;
+        cpu_set_t one;
+        w->pool = p;
+        w->id = i;
+        w->cpu = cpus[i % nr_cpus];
+        if (pthread_create(&w->thread, NULL, worker_thread, w))
+            perror("pthread_create"), exit(1);
+        CPU_ZERO(&one);
+        CPU_SET(w->cpu, &one);
+        if (pthread_setaffinity_np(w->thread, sizeof (one), &one))
+          {
+            fprintf(stderr, "CPU thread %d: cannot pin to CPU %d\n", i, w->cpu);
+            w->cpu = -1;
+          }
+        if (verbose)
+            printf("CPU thread %d: pinned to CPU %d\n", i, w->cpu);
+      }
+    return p;
+}
+
+/*
+ * Makes every worker call fn(arg, worker) once. Returns immediately; use
+ * cpu_pool_busy to know when they are done.
+ */
+void cpu_pool_run(cpu_pool_t *p, cpu_task_fn fn, void *arg)
+{
+    pthread_mutex_lock(&p->lock);
+    p->fn = fn;
+    p->arg = arg;
+    p->pending = p->nr_workers;
+    p->generation++;
+    pthread_cond_broadcast(&p->start);
+    pthread_mutex_unlock(&p->lock);
+}
+
+/*
+ * Blocks until the current run is complete.
+ */
+void cpu_pool_wait(cpu_pool_t *p)
+{
+    pthread_mutex_lock(&p->lock);
+    while (p->pending > 0)
+        pthread_cond_wait(&p->done, &p->lock);
+    pthread_mutex_unlock(&p->lock);
+}
+
+bool cpu_pool_busy(cpu_pool_t *p)
+{
+    pthread_mutex_lock(&p->lock);
+    bool busy = p->pending > 0;
+    pthread_mutex_unlock(&p->lock);
+    return busy;
+}
+
+/*
+ * Prints the hash rate of every worker since the previous call, from the
+ * hashes its runs returned: like the rate of the device, it leaves out the
+ * parked elements.
+ */
+void cpu_pool_show_rates(cpu_pool_t *p)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    double us = (now.tv_sec - p->ts_rates.tv_sec) * 1e6 +
+        (now.tv_nsec - p->ts_rates.tv_nsec) / 1e3;
+    p->ts_rates = now;
+    if (us <= 0)
+        return;
+    printf("CPU threads (Mhash/sec):");
+    pthread_mutex_lock(&p->lock);
+    for (int i = 0; i < p->nr_workers; i++)
+      {
+        printf(" %.1f", p->workers[i].hashes / us);
+        p->workers[i].hashes = 0;
+      }
+    pthread_mutex_unlock(&p->lock);
+    printf("\n");
+}
+
+/*
+ * Waits for the current run to complete, and stops the workers.
+ */
+void cpu_pool_destroy(cpu_pool_t *p)
+{
+    // a worker that has not picked up the run yet would see quit first
+    cpu_pool_wait(p);
+    pthread_mutex_lock(&p->lock);
+    p->quit = true;
+    pthread_cond_broadcast(&p->start);
+    pthread_mutex_unlock(&p->lock);
+    for (int i = 0; i < p->nr_workers; i++)
+        pthread_join(p->workers[i].thread, NULL);
+    pthread_cond_destroy(&p->start);
+    pthread_cond_destroy(&p->done);
+    pthread_mutex_destroy(&p->lock);
+    free(p->workers);
+    free(p);
+}
@@ -0,0 +1,33 @@
+/*
+ * Pool of host threads hashing for the CPU device. Worker i does on the host
+ * what thread i of the kernel does on a GPU.
+ */
+
+// runs the share of a kernel run of one worker, returns the hashes it did
+// that count (not those of parked elements)
+typedef uint64_t (*cpu_task_fn)(void *arg, int worker);
+
+typedef struct cpu_worker cpu_worker_t;
+
+typedef struct
+{
+    int			nr_workers;
+    cpu_worker_t	*workers;
+    pthread_mutex_t	lock;
+    pthread_cond_t	start;
+    pthread_cond_t	done;		// signaled when a run completes
+    unsigned		generation;	// incremented by every run
+    int			pending;	// workers still busy with this run
+    cpu_task_fn		fn;
+    void		*arg;
+    bool		quit;
+    struct timespec	ts_rates;	// last call to cpu_pool_show_rates
+}		cpu_pool_t;
+
+cpu_pool_t *cpu_pool_create(int nr_workers, const char *cpuset_str,
+        bool use_smt, int verbose);
+void cpu_pool_run(cpu_pool_t *p, cpu_task_fn fn, void *arg);
+void cpu_pool_wait(cpu_pool_t *p);
+bool cpu_pool_busy(cpu_pool_t *p);
+void cpu_pool_show_rates(cpu_pool_t *p);
+void cpu_pool_destroy(cpu_pool_t *p);
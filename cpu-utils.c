@@ -0,0 +1,154 @@
+#define _POSIX_C_SOURCE 199309L
+#include <cpuid.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "sha256-utils.h"
+#include "cpu-utils.h"
+
+// time spent measuring the hash rate of each engine
+const unsigned calibration_ms = 100;
+
+/*
+ * Returns true iff the OS saves the given state components (XCR0 bits) on
+ * context switches, which is required before using the AVX registers.
+ */
+static bool os_saves(uint32_t xcr0_mask)
+{
+    unsigned a, b, c, d;
+    if (!__get_cpuid(1, &a, &b, &c, &d) || !(c & bit_OSXSAVE))
+        return false;
+    __asm__ volatile ("xgetbv" : "=a" (a), "=d" (d) : "c" (0));
+    return (a & xcr0_mask) == xcr0_mask;
+}
+
+static bool cpuid7_ebx(unsigned bit)
+{
+    unsigned a, b, c, d;
+    if (!__get_cpuid_count(7, 0, &a, &b, &c, &d))
+        return false;
+    return b & bit;
+}
+
+static bool have_scalar(void)
+{
+    return true;
+}
+
+static bool have_avx2(void)
+{
+    // XCR0: SSE and AVX state
+    return cpuid7_ebx(bit_AVX2) && os_saves(0x6);
+}
+
+static bool have_avx512(void)
+{
+    // XCR0: SSE, AVX, opmask, ZMM0-15 upper halves and ZMM16-31 state
+    return cpuid7_ebx(bit_AVX512F) && os_saves(0xe6);
+}
+
+static bool have_shani(void)
+{
+    unsigned a, b, c, d;
+    if (!__get_cpuid(1, &a, &b, &c, &d) || !(c & bit_SSE4_1))
+        return false;
+    return cpuid7_ebx(bit_SHA);
+}
+
+static cpu_engine_t engines[] = {
+    { "scalar", have_scalar, sha256d_scan_scalar, 0 },
+    { "AVX2", have_avx2, sha256d_scan_avx2, 0 },
+    { "AVX-512", have_avx512, sha256d_scan_avx512, 0 },
+    { "SHA-NI", have_shani, sha256d_scan_shani, 0 },
+};
+
+static double now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+/*
+ * Checks the engine against the block solved by sha256_test_nonce, the same
+ * dummy block generate_il uses. Ranges of odd sizes and hash limits exercise
+ * the partial passes of the multi-lane engines.
+ */
+static bool known_answer_test(const cpu_engine_t *e, const sha256_work_t *w)
+{
+    const uint32_t n = sha256_test_nonce;
+    uint32_t cur;
+    // range ending right before the solution
+    cur = n - 37;
+    if (e->scan(w, &cur, n, 1000) || cur != n)
+        return false;
+    // range containing the solution: the scan stops right after it
+    cur = n - 37;
+    if (!e->scan(w, &cur, n + 100, 1000) || cur != n + 1)
+        return false;
+    // hash limit reached before the solution
+    cur = n - 37;
+    if (e->scan(w, &cur, n + 100, 21) || cur != n - 16)
+        return false;
+    return true;
+}
+
+/*
+ * Returns the single-thread hash rate of the engine in Mhash/sec.
+ */
+static double calibrate(const cpu_engine_t *e, const sha256_work_t *w)
+{
+    const unsigned chunk = 0x4000;
+    uint32_t cur = sha256_test_nonce + 1;
+    uint64_t hashes = 0;
+    double t0 = now_ms(), t;
+    do
+      {
+        e->scan(w, &cur, 0, chunk);
+        hashes += chunk;
+      }
+    while ((t = now_ms() - t0) < calibration_ms);
+    return hashes / t / 1e3;
+}
+
+/*
+ * Probes the engines supported by this CPU, runs a known-answer test on each
+ * of them, and returns the fastest correct one. The scalar engine is the
+ * reference implementation and always qualifies.
+ */
+const cpu_engine_t *cpu_engine_select(int verbose)
+{
+    cpu_engine_t *best = NULL;
+    uint32_t datawords[32] = { 0 };
+    sha256_work_t w;
+    memcpy(datawords + 16, sha256_test_data, sizeof (sha256_test_data));
+    sha256_work_init(&w, datawords, sha256_test_midstate);
+    for (unsigned i = 0; i < sizeof (engines) / sizeof (*engines); i++)
+      {
+        cpu_engine_t *e = engines + i;
+        if (!e->supported())
+          {
+            if (verbose)
+                printf("CPU engine %s: not supported by this CPU\n", e->name);
+            continue;
+          }
+        if (!known_answer_test(e, &w))
+          {
+            fprintf(stderr, "CPU engine %s: failed known-answer test, "
+                    "disabled\n", e->name);
+            continue;
+          }
+        e->mhashpsec = calibrate(e, &w);
+        if (verbose)
+            printf("CPU engine %s: %.1f Mhash/sec\n", e->name, e->mhashpsec);
+        if (!best || e->mhashpsec > best->mhashpsec)
+            best = e;
+      }
+    if (!best)
+        fprintf(stderr, "No working CPU engine\n"), exit(1);
+    return best;
+}
@@ -0,0 +1,12 @@
+/*
+ * Double SHA-256 engines available to hash on the host CPU.
+ */
+typedef struct
+{
+    const char		*name;
+    bool		(*supported)(void);	// probes cpuid
+    sha256d_scan_fn	scan;
+    double		mhashpsec;	// single thread, measured at startup
+}		cpu_engine_t;
+
+const cpu_engine_t *cpu_engine_select(int verbose);
@@ -0,0 +1,48 @@
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "hash-rate.h"
+
+void hash_rate_init(hash_rate_t *r)
+{
+    memset(r, 0, sizeof (*r));
+}
+
+/*
+ * Accounts for a run that scanned nonces between times start and end, in
+ * seconds.
+ */
+void hash_rate_add(hash_rate_t *r, uint64_t nonces, double start, double end)
+{
+    double t = end - start;
+    if (!r->nr_runs)
+        r->since = start;
+    else if (r->nr_runs >= HASH_RATE_RUNS)
+        // the window now starts after the run forgotten
+        r->since = r->runs[r->next].end;
+    r->runs[r->next].end = end;
+    r->runs[r->next].nonces = nonces;
+    r->next = (r->next + 1) % HASH_RATE_RUNS;
+    r->nr_runs++;
+    if (t <= 0)
+        return;
+    if (!r->ewma)
+        r->ewma = nonces / t;
+    else
+        r->ewma += (nonces / t - r->ewma) * (1 - exp(-t / HASH_RATE_TAU));
+}
+
+/*
+ * Returns the hash/sec of the runs that ended in the last HASH_RATE_WINDOW
+ * seconds before now, or since the first run if that is more recent.
+ */
+double hash_rate_window(const hash_rate_t *r, double now)
+{
+    double from = fmax(now - HASH_RATE_WINDOW, r->since);
+    uint64_t nonces = 0;
+    for (unsigned i = 0; i < r->nr_runs && i < HASH_RATE_RUNS; i++)
+        if (r->runs[i].end > from)
+            nonces += r->runs[i].nonces;
+    return now > from ? nonces / (now - from) : 0;
+}
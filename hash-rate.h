@@ -0,0 +1,32 @@
+/*
+ * Hash rate of a device, from the nonces its runs actually scanned rather
+ * than the iterations they were seeded with: elements stop early on a
+ * candidate or at the end of their range. Two rates are kept:
+ *
+ * - an exponentially weighted moving average of the rate of the runs
+ *   themselves, each weighted by its duration: the speed of the device;
+ * - the nonces of the runs that ended in the last HASH_RATE_WINDOW seconds
+ *   over the wall time, which counts the host time between runs too: what
+ *   the device delivers.
+ */
+
+#define HASH_RATE_TAU		5.	// seconds, time constant of the average
+#define HASH_RATE_WINDOW	30.	// seconds
+#define HASH_RATE_RUNS		512	// runs remembered for the window
+
+typedef struct
+{
+    double	ewma;		// hash/sec, 0 until the first run
+    double	since;		// start of what the runs remembered cover
+    struct
+      {
+        double		end;
+        uint64_t	nonces;
+      }		runs[HASH_RATE_RUNS]; // ring, oldest at next
+    unsigned	next;
+    unsigned	nr_runs;
+}		hash_rate_t;
+
+void hash_rate_init(hash_rate_t *r);
+void hash_rate_add(hash_rate_t *r, uint64_t nonces, double start, double end);
+double hash_rate_window(const hash_rate_t *r, double now);
@@ -23,7 +23,18 @@
 
 #include "cal-utils.h"
 #include "miner-utils.h"
+#include "sha256-utils.h"
+#include "cpu-utils.h"
+#include "cpu-pool.h"
+#include "nonce-sched.h"
+#include "hash-rate.h"
+#include "image-cache.h"
+#include "compile-pool.h"
+#include "il-interp.h"
 #include "kernel-sha256.h"
+#include "kernel-sha256-cbuf.h"
+#include "kernel-sha256-compact.h"
+#include "kernel-sha256-cbuf-compact.h"
 
 // hardcoded limit of 64*128 = 8192 GPUs.
 // Moore's law: this won't be sufficient after around 2025.
@@ -31,41 +42,71 @@ uint64_t gpuset[128];
 
 const char *auth = "bitcoin:password";
 int disassemble_target = -1;
+const char *save_object_path = NULL;
+const char *analyze_object_path = NULL;
+const char *cache_dir = NULL; // NULL means the default, "" disables caching
 unsigned max_gpus = 0;
 const char *server = "localhost";
 unsigned iterations = 0x1000;
+unsigned nonce_chunk = 0; // 0 means 4 runs worth of nonces
+// the iterations of each device are adjusted after its runs so that they last
+// about this long, 0 keeps them fixed
+unsigned tune_run_ms = 100;
+const unsigned min_iterations = 0x100;
+const unsigned max_iterations = 0x400000;
+// work items with nonces left are dropped after this many seconds, so are
+// work items prepared ahead
+const unsigned carry_over_max_age = 60;
+// work items prepared ahead for each device
+unsigned work_ahead = 2;
 unsigned port = 8332;
 int threads_per_grp = 320;
+// with tune_run_ms, the number of threads per group of each GPU is picked at
+// startup among these, unless given with -t
+bool tune_threads_per_grp = true;
+const int threads_per_grp_sweep[] = { 64, 128, 192, 256, 320, 384 };
+// where the kernel reads the per-work values from: literals require a
+// compilation per work item (or a patch of the image of one compiled with
+// sentinel values), a constant buffer only one compilation per device
+enum { KERNEL_LITERAL, KERNEL_PATCH, KERNEL_CBUF } kernel_mode = KERNEL_CBUF;
+// check each patched image against a recompile
+bool verify_patch = false;
+// the kernel appends candidates to a small result buffer and keeps the nonces
+// of the elements on the device, instead of writing back the state of every
+// element for the host to read after each run
+bool compact_results = false;
+// where the state tables and result buffers of the GPUs are: in their local
+// memory, mapped (a copy over the bus) to be read or seeded, or with -M in
+// uncached or cached remote memory, host RAM the device reads and writes
+// over the bus, mapped once for good
+enum { MEM_LOCAL, MEM_UNCACHED, MEM_CACHED } state_mem = MEM_LOCAL;
+bool cpu_mode = false;
+sha256d_scan_fn cpu_scan = sha256d_scan_scalar;
+// with -K, the CPU device runs the cbuf kernel compiled to native code
+// instead of cpu_scan
+bool cpu_use_kernel = false;
+il_native_t *cpu_kernel = NULL;
+int cpu_threads = 0; // 0 means one per CPU
+const char *cpuset_str = NULL;
+bool cpu_smt = true;
+// CPU runs are sized from the engine speed to last about this long
+const unsigned cpu_run_ms = 100;
+unsigned cpu_iterations;
 int verbose = 0;
+// with -X, the kernels are checked with the IL interpreter over this many
+// nonces each instead of mining
+unsigned long long check_nonces = 0;
 const unsigned show_stats_every_x_ms = 1000;
-uint32_t k_constants[] = {
-    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
-    0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
-    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
-    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
-    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
-    0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
-    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
-    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
-    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
-    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
-    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
-    0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
-    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
-    0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
-    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
-    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
-};
 int pipefd[2];
 uint8_t target[32];
-// Kernel is about 140kB, but scan for more bytes due to incertitude of
-// the exact ELF layout.
-const unsigned bytes_to_patch = 220000;
-// Number of instruction patched should be at most 8 (elements) * 64 (rounds) *
-// 2 (SHA-256 hash) but it is less because the CAL compiler optimizes out some
-// computations.
-const int expected_patched_instr_min = 950;
-const int expected_patched_instr_max = 1024;
+// Kernel is about 140kB; the ELF headers of the compiled object must fit in
+// this size to be trusted.
+const unsigned max_object_size = 1 << 20;
+// Number of instruction patched should be at most 8 (elements) * 124 (rounds:
+// the first hash starts at round 4) but it is less because the CAL compiler
+// optimizes out some computations.
+const int expected_patched_instr_min = 920;
+const int expected_patched_instr_max = 992;
 char *rpc_url = NULL;
 
 const uint8_t s_searching = 0; // still searching this data block
@@ -78,7 +119,7 @@ typedef struct
     uint8_t	_unused0[3];
     uint32_t	cur_nonce;
     uint32_t	end_nonce;
-    uint32_t	_unused1;
+    uint32_t	iterations; // of the run, the kernel reads those of element 0
 } __attribute__((packed))	elm_state_t;
 
 typedef struct
@@ -88,31 +129,114 @@ typedef struct
     elm_state_t	elm[ELM_PER_THREAD];
 } __attribute__((packed))	thread_state_t;
 
+/*
+ * A getwork item. It is referenced by the device preparing or scanning it, and
+ * by the carry-over queue when nonces are left to scan.
+ */
+typedef struct work_item
+{
+    int			refs;
+    struct gpu_state	*gs;		// device it was prepared for
+    volatile bool	ready;		// prepared (compiled if need be)
+    uint32_t		datawords[32];
+    uint32_t		midstate[8];
+    sha256_work_t	work;		// precomputed from the two above
+    // img is compiled for target and threads_per_grp (KERNEL_LITERAL/PATCH,
+    // GPU only)
+    CALtarget		target;
+    int			threads_per_grp;
+    CALimage		img;
+    unsigned		block_id;	// see last_prevhash
+    struct timeval	tv_fetched;
+    nonce_range_t	*left;		// nonces left when carried over
+    int			nr_left;
+    struct work_item	*next_carried;
+}		work_item_t;
+
+/*
+ * Result buffer of a run with compact_results.
+ */
+#define RESULT_SLOTS	6 // keep in sync with result_slots in Perl code
+typedef struct
+{
+    uint32_t	nonce;
+    uint32_t	elm; // ELM_PER_THREAD * thread + element
+}		candidate_t;
+
+typedef struct
+{
+    // candidates appended; those overflowing overwrite the last slot, which
+    // holds the latest of them
+    uint32_t	count;
+    uint32_t	_unused[3];
+    candidate_t	found[RESULT_SLOTS];
+}		results_t;
+
+/*
+ * A state table of a device. Each device has two, run alternately: the host
+ * analyzes the results of one and seeds it with new ranges while the device
+ * scans the other.
+ */
+#define NR_STATE_BUFS	2
 typedef struct
 {
+    CALresource		res;
+    CALmem		mem;
+    thread_state_t	*host; // of a CPU device, or mapped remote memory
+    // with compact_results
+    CALresource		resultsRes;
+    CALmem		resultsMem;
+    results_t		*hostResults; // same
+    nonce_range_t	*ranges; // of the elements, as the device has them
+    unsigned		iterations; // of the run it is seeded for
+    uint64_t		scanned; // nonces scanned in its run by unparked elements
+    uint64_t		full; // same, had none of them stopped early
+    bool		seeded; // holds the ranges of a run not started yet
+    struct timeval	tv_start;
+    struct timeval	tv_end;
+}		state_buf_t;
+
+typedef struct gpu_state
+{
+    CALuint		devi;
+    pthread_t		thread; // feeding the device
     unsigned		nr_simds;
     bool		used;
+    bool		cpu; // hashes on the host CPU instead of a CAL device
+    bool		remote; // tables and result buffers in remote memory
     int			nr_threads;
+    int			threads_per_grp;
+    unsigned		iterations; // per element and per run, for the next runs
     CALtarget		target;
-    CALimage		img;
+    CALimage		img; // KERNEL_CBUF kernel, compiled once
+    image_patch_t	patch; // KERNEL_PATCH image, no bytes if unpatchable
     CALdevice		device;
     CALcontext		ctx;
     CALmodule		module;
-    CALresource		globalRes;
-    CALmem		globalMem;
+    state_buf_t		buf[NR_STATE_BUFS];
+    CALname		globalName; // "g[]", bound to the table of each run
+    CALname		resultsName; // "uav1", likewise with compact_results
+    int			run_buf; // table being scanned, -1 if none
+    int			last_buf; // table of the last run started
     CALresource		constRes;
     CALmem		constMem;
+    CALresource		workRes; // "cb1" of the KERNEL_CBUF kernel
+    CALmem		workMem;
     CALprogramGrid	pg;
     CALevent		e;
+    cpu_pool_t		*pool;
+    nonce_sched_t	sched;
     bool		have_run;
-    struct timeval	tv_start;
-    struct timeval	tv_end;
-    int			last_mhashpsec;
-    uint32_t		datawords[32];
-    uint32_t		midstate[8];
-    CALimage		next_img;
-    uint32_t		next_datawords[32];
-    uint32_t		next_midstate[8];
+    hash_rate_t		rate;
+    // of rate, for the other threads
+    double		mhashpsec; // average
+    double		window_mhashpsec;
+    work_item_t		*cur;
+    // work items being prepared or ready, oldest first, filled up to
+    // work_ahead by the controller thread
+    pthread_mutex_t	ahead_lock;
+    work_item_t		**ahead;
+    unsigned		nr_ahead;
 }		gpu_state_t;
 
 enum iid
@@ -127,11 +251,24 @@ typedef struct
     CALuint     devi;
     // used by CREATE_NEXT_WORK_ITEM
     gpu_state_t *gs;
+    double	lead_time; // seconds until the device needs the item
     // used by VERIFY_POTENTIAL_FIND
     uint32_t	datawords[32];
     uint32_t	nonce;
 }               instr_t;
 
+// previous block hash of the last work item fetched, and a counter of its
+// changes: work items of older blocks are stale
+uint32_t last_prevhash[8];
+volatile unsigned block_id = 0;
+// FIFO of work items with nonces left, re-issued before new work
+work_item_t *carried = NULL;
+pthread_mutex_t carried_lock = PTHREAD_MUTEX_INITIALIZER;
+// compiles kernels for all GPUs
+compile_pool_t *compile_pool = NULL;
+// cleared if the CAL runtime cannot block on events, device threads then poll
+volatile bool cal_wait_events = true;
+
 /**
 ** Returns true iff the user selected running on this GPU device.
 */
@@ -284,59 +421,349 @@ out:
     return false;
 }
 
-void generate_il(char **src, uint32_t datw[], uint32_t mids[])
+void generate_il(char **src, const sha256_work_t *w, int tpg)
 {
-    // dummy second data block (last 64 bytes)
-    uint32_t *dat = (uint32_t *)
-        "\x20\x87\x4c\x04\x4d\x0c\x82\x5c\x1c\x45\x12\x08\x29\xfb\xd3\x00"
-        "\x00\x00\x00\x80\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"
-        "\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"
-        "\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x80\x02\x00\x00";
-    // dummy mid-state
-    uint32_t *sta = (uint32_t *)
-        "\x5a\xcb\x58\x60\x4e\x38\x72\xde\x3c\x8d\xe3\xfa\x39\x2e\x21\xf6"
-        "\x2f\x5a\xfb\x0c\x29\xe6\xeb\x20\x77\xce\xe9\x9c\x3f\x5a\xfb\xc2";
-    if (datw || mids)
+    sha256_work_t dummy;
+    if (!w)
+      {
+        // dummy second data block (last 64 bytes) and mid-state
+        uint32_t datawords[32] = { 0 };
+        memcpy(datawords + 16, sha256_test_data, sizeof (sha256_test_data));
+        sha256_work_init(&dummy, datawords, sha256_test_midstate);
+        w = &dummy;
+      }
+    const uint32_t *sta = w->midstate;
+    const uint32_t *st4 = w->st4;
+    if (kernel_mode == KERNEL_CBUF)
       {
-        assert(datw);
-        assert(mids);
-        dat = datw + 16;
-        sta = mids;
+        // per-work values are written to cb1 by set_work_constants
+        if (-1 == asprintf(src, compact_results ?
+                    KERNEL_SHA256_CBUF_COMPACT : KERNEL_SHA256_CBUF,
+                    tpg,
+                    sizeof (thread_state_t) / 16,
+                    s_found, s_finished))
+            perror("asprintf"), exit(1);
+        return;
       }
-    if (-1 == asprintf(src, KERNEL_SHA256,
-                threads_per_grp, iterations,
+    if (-1 == asprintf(src, compact_results ?
+                KERNEL_SHA256_COMPACT : KERNEL_SHA256,
+                tpg,
                 sizeof (thread_state_t) / 16 /* size of x,y,z,w IL elements */,
                 s_found, s_finished,
-                // give the kernel only the non-zero data words
-                dat[0], dat[1], dat[2],
                 sta[0], sta[1], sta[2], sta[3],
-                sta[4], sta[5], sta[6], sta[7]))
+                sta[4], sta[5], sta[6], sta[7],
+                // the kernel starts at round 4 from these precomputed values
+                st4[0], st4[1], st4[2], st4[3],
+                st4[4], st4[5], st4[6], st4[7],
+                w->w16, w->w17, w->w18, w->w19,
+                w->w31))
         perror("asprintf"), exit(1);
 }
 
+// number of per-work values in cb1 (and of per-work literals): the midstate,
+// st4, w16-w19 and w31
+#define NR_WORK_VALUES	21
+
+/*
+ * Returns the per-work values of the KERNEL_CBUF kernel, laid out as its cb1.
+ */
+void work_constants(uint32_t cb[32], const sha256_work_t *w)
+{
+    memset(cb, 0, 32 * sizeof (*cb));
+    memcpy(cb, w->midstate, 8 * sizeof (*cb));
+    memcpy(cb + 8, w->st4, 8 * sizeof (*cb));
+    cb[16] = w->w16;
+    cb[17] = w->w17;
+    cb[18] = w->w18;
+    cb[19] = w->w19;
+    cb[20] = w->w31;
+}
+
+/*
+ * Opposite of work_constants, for sentinel values.
+ */
+void work_from_constants(sha256_work_t *w, const uint32_t cb[32])
+{
+    memset(w, 0, sizeof (*w));
+    memcpy(w->midstate, cb, 8 * sizeof (*cb));
+    memcpy(w->st4, cb + 8, 8 * sizeof (*cb));
+    w->w16 = cb[16];
+    w->w17 = cb[17];
+    w->w18 = cb[18];
+    w->w19 = cb[19];
+    w->w31 = cb[20];
+}
+
+/*
+ * Returns the image of the kernel for w (see generate_il), target and tpg
+ * threads per group, from the image cache if it has it and cache is true
+ * (there is no point caching the image of a single work item). With -o, the
+ * kernel is always compiled, for its object to be saved. Free it with
+ * calImageFree.
+ */
+CALimage compile_kernel(const sha256_work_t *w, CALtarget target, int tpg,
+        bool cache)
+{
+    char *src;
+    CALobject obj;
+    CALimage img;
+    uint8_t key[32];
+    generate_il(&src, w, tpg);
+    image_cache_key(key, src, target, tpg);
+    if (cache && !save_object_path && image_cache_load(key, &img))
+      {
+        free(src);
+        return img;
+      }
+    if (CAL_RESULT_OK != calclCompile(&obj, CAL_LANGUAGE_IL, src, target))
+        fatal("calclCompile");
+    free(src);
+    if (save_object_path)
+        save_cal_object(save_object_path, &obj, max_object_size);
+#ifndef CALSHIM
+    // the objects of the software runtime hold IL, there is no ISA to patch
+    patch_bfi_int_instructions(verbose, &obj, max_object_size,
+            expected_patched_instr_min, expected_patched_instr_max);
+#endif
+    if (CAL_RESULT_OK != calclLink(&img, &obj, 1))
+        fatal("calclLink");
+    if (CAL_RESULT_OK != calclFreeObject(obj))
+        fatal("calclFreeObject");
+    return image_cache_add(cache ? key : NULL, img);
+}
+
+/*
+ * With KERNEL_PATCH, compiles the literal kernel with two sets of sentinel
+ * values to locate the literals in its image. Each work item then only costs
+ * a copy of the image with its values stamped in. If they cannot be located,
+ * work items are compiled like with KERNEL_LITERAL.
+ */
+void prepare_patch(gpu_state_t *gs)
+{
+    uint32_t sentinels[2][32] = { { 0 } };
+    CALimage img[2];
+    sha256_work_t w;
+    for (int s = 0; s < 2; s++)
+      {
+        for (int i = 0; i < NR_WORK_VALUES; i++)
+            sentinels[s][i] = (s ? 0x5ac30000 : 0xc35a0000) | i << 8 | 0x6b;
+        work_from_constants(&w, sentinels[s]);
+        img[s] = compile_kernel(&w, gs->target, gs->threads_per_grp, true);
+      }
+    if (image_patch_init(&gs->patch, img[0], img[1], sentinels[0],
+                sentinels[1], NR_WORK_VALUES))
+      {
+        if (verbose)
+            printf("Device %u: %i literal sites in the kernel image\n",
+                    gs->devi, gs->patch.nr_sites);
+      }
+    else
+        fprintf(stderr, "Device %u: compiling each work item instead\n",
+                gs->devi);
+    for (int s = 0; s < 2; s++)
+        if (CAL_RESULT_OK != calImageFree(img[s]))
+            fatal("calImageFree");
+}
+
+/*
+ * Returns the image of the literal kernel for w, patched or compiled.
+ */
+CALimage work_kernel(gpu_state_t *gs, const sha256_work_t *w)
+{
+    uint32_t cb[32];
+    work_constants(cb, w);
+    if (kernel_mode != KERNEL_PATCH || !gs->patch.bytes ||
+            !image_patch_values_ok(cb, NR_WORK_VALUES))
+        return compile_kernel(w, gs->target, gs->threads_per_grp, false);
+    CALimage img = image_patch_apply(&gs->patch, cb);
+    if (verify_patch)
+      {
+        CALimage ref = compile_kernel(w, gs->target, gs->threads_per_grp,
+                false);
+        if (!image_equal(img, ref))
+            fprintf(stderr, "Error: patched kernel differs from its "
+                    "recompilation\n"), exit(1);
+        if (verbose)
+            printf("Patched kernel verified\n");
+        if (CAL_RESULT_OK != calImageFree(ref))
+            fatal("calImageFree");
+      }
+    return img;
+}
+
+/*
+ * Compile pool job preparing the image of a work item of a GPU. Items that
+ * became stale meanwhile are not worth it: they are only marked ready so that
+ * the device drops them.
+ */
+void compile_work_item(void *arg)
+{
+    work_item_t *w = arg;
+    if (w->block_id == block_id)
+      {
+        w->img = work_kernel(w->gs, &w->work);
+        w->target = w->gs->target;
+        w->threads_per_grp = w->gs->threads_per_grp;
+      }
+    w->ready = true;
+}
+
 /*
- * Acquire next work item, compile, and save it in the next_* member variables.
+ * Acquire a work item and queue it among those prepared ahead for the device.
+ * If it needs to be compiled, it is only ready once the compile pool has done
+ * so, which the device needs in lead_time seconds.
  */
-void create_next_work_item(CALuint devi, gpu_state_t *gs)
+void create_next_work_item(CALuint devi, gpu_state_t *gs, double lead_time)
 {
-        char *src;
-        CALobject obj;
+        work_item_t *w = calloc(1, sizeof (*w));
+        if (!w)
+            perror("calloc"), exit(1);
+        w->refs = 1;
+        w->gs = gs;
         if (verbose)
             printf("Getting new work for GPU %u\n", devi);
-        rpc_get_work(gs->next_datawords, gs->next_midstate);
-        // compile and link
-        generate_il(&src, gs->next_datawords, gs->next_midstate);
-        if (CAL_RESULT_OK != calclCompile(&obj, CAL_LANGUAGE_IL, src,
-                    gs->target))
-            fatal("calclCompile");
-        free(src);
-        if (1)
-            patch_bfi_int_instructions(verbose, &obj, bytes_to_patch,
-                    expected_patched_instr_min, expected_patched_instr_max);
-        if (CAL_RESULT_OK != calclLink(&gs->next_img, &obj, 1))
-            fatal("calclLink");
-        if (CAL_RESULT_OK != calclFreeObject(obj))
-            fatal("calclFreeObject");
+        rpc_get_work(w->datawords, w->midstate);
+        gettimeofday(&w->tv_fetched, NULL);
+        // the previous block hash is in data words 1-8
+        if (memcmp(last_prevhash, w->datawords + 1, sizeof (last_prevhash)))
+          {
+            memcpy(last_prevhash, w->datawords + 1, sizeof (last_prevhash));
+            block_id++;
+          }
+        w->block_id = block_id;
+        sha256_work_init(&w->work, w->datawords, w->midstate);
+        // nothing to compile for the CPU, nor with KERNEL_CBUF
+        w->ready = gs->cpu || kernel_mode == KERNEL_CBUF;
+        pthread_mutex_lock(&gs->ahead_lock);
+        gs->ahead[gs->nr_ahead++] = w;
+        pthread_mutex_unlock(&gs->ahead_lock);
+        if (!w->ready)
+            compile_pool_submit(compile_pool, compile_work_item, w, lead_time);
+}
+
+void work_item_release(work_item_t *w)
+{
+    if (--w->refs)
+        return;
+    if (w->img && CAL_RESULT_OK != calImageFree(w->img))
+        fatal("calImageFree");
+    free(w->left);
+    free(w);
+}
+
+/*
+ * Returns the oldest carried-over work item the device can scan (the CPU, or
+ * a GPU with KERNEL_CBUF, can scan any, otherwise a GPU needs one compiled for
+ * its target and threads per group), or NULL. Stale items are dropped along
+ * the way.
+ */
+work_item_t *take_carried(gpu_state_t *gs)
+{
+    struct timeval now;
+    work_item_t **pw = &carried, *taken = NULL;
+    gettimeofday(&now, NULL);
+    pthread_mutex_lock(&carried_lock);
+    while (*pw)
+      {
+        work_item_t *w = *pw;
+        if (w->block_id != block_id ||
+                now.tv_sec - w->tv_fetched.tv_sec > carry_over_max_age)
+          {
+            *pw = w->next_carried;
+            work_item_release(w);
+            continue;
+          }
+        if (gs->cpu || kernel_mode == KERNEL_CBUF ||
+                (w->img && w->target == gs->target &&
+                 w->threads_per_grp == gs->threads_per_grp))
+          {
+            *pw = w->next_carried;
+            taken = w;
+            break;
+          }
+        pw = &w->next_carried;
+      }
+    pthread_mutex_unlock(&carried_lock);
+    return taken;
+}
+
+/*
+ * Queues a work item with nonces left, handing over the reference of the
+ * caller.
+ */
+void queue_carried(CALuint devi, work_item_t *w)
+{
+    work_item_t **pw = &carried;
+    if (verbose)
+      {
+        uint64_t n = 0;
+        for (int i = 0; i < w->nr_left; i++)
+            n += w->left[i].end - w->left[i].cur;
+        printf("Device %u: carrying over %llu nonces in %d ranges\n",
+                devi, (unsigned long long)n, w->nr_left);
+      }
+    pthread_mutex_lock(&carried_lock);
+    while (*pw)
+        pw = &(*pw)->next_carried;
+    w->next_carried = NULL;
+    *pw = w;
+    pthread_mutex_unlock(&carried_lock);
+}
+
+/*
+ * Tells the controller thread to acquire a work item for the device, to be
+ * queued after the nr_ahead ones it has: it is needed once they and the
+ * current item are scanned.
+ */
+void request_work_item(CALuint devi, gpu_state_t *gs, unsigned nr_ahead)
+{
+    instr_t *i = malloc(sizeof (*i));
+    if (!i)
+        perror("malloc instruction"), exit(1);
+    i->id = CREATE_NEXT_WORK_ITEM;
+    i->devi = devi;
+    i->gs = gs;
+    i->lead_time = gs->window_mhashpsec ? (nonce_sched_left(&gs->sched) +
+            nr_ahead * 0x100000000ULL) / (gs->window_mhashpsec * 1e6) : 0;
+    if (-1 == write(pipefd[1], &i, sizeof (i)))
+	perror("request_work_item: write"), exit(1);
+}
+
+/*
+ * Drops the work items prepared ahead for the device that became stale (as
+ * soon as they are ready, ie. no longer being compiled) and asks for new ones.
+ * If take, removes and returns the oldest ready one, if any, and asks for a
+ * new one to replace it.
+ */
+work_item_t *refresh_ahead(CALuint devi, gpu_state_t *gs, bool take)
+{
+    work_item_t *taken = NULL;
+    unsigned dropped = 0, kept = 0;
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    pthread_mutex_lock(&gs->ahead_lock);
+    for (unsigned i = 0; i < gs->nr_ahead; i++)
+      {
+        work_item_t *w = gs->ahead[i];
+        if (w->ready && (w->block_id != block_id ||
+                    now.tv_sec - w->tv_fetched.tv_sec > carry_over_max_age))
+          {
+            work_item_release(w);
+            dropped++;
+          }
+        else if (take && !taken && w->ready)
+            taken = w;
+        else
+            gs->ahead[kept++] = w;
+      }
+    gs->nr_ahead = kept;
+    pthread_mutex_unlock(&gs->ahead_lock);
+    if (dropped && verbose)
+        printf("Device %u: dropped %u stale work item%s\n", devi, dropped,
+                dropped != 1 ? "s" : "");
+    for (unsigned i = 0; i < dropped + !!taken; i++)
+        request_work_item(devi, gs, kept + i);
+    return taken;
 }
 
 void verify_potential_find(CALuint devi, uint32_t datawords[], uint32_t nonce)
@@ -345,55 +772,134 @@ void verify_potential_find(CALuint devi, uint32_t datawords[], uint32_t nonce)
     rpc_submit_work(devi, datawords, nonce);
 }
 
+/*
+ * Sets up the scheduler of the device, and what the host knows of its tables,
+ * for its number of threads.
+ */
+void init_sched(CALuint devi, gpu_state_t *gs)
+{
+    // the device tables hold no known range yet
+    for (int b = 0; compact_results && b < NR_STATE_BUFS; b++)
+      {
+        size_t size = gs->nr_threads * ELM_PER_THREAD * sizeof (nonce_range_t);
+        if (!(gs->buf[b].ranges = malloc(size)))
+            perror("malloc"), exit(1);
+        memset(gs->buf[b].ranges, 0xff, size);
+      }
+    nonce_sched_init(&gs->sched,
+            NR_STATE_BUFS * gs->nr_threads * ELM_PER_THREAD,
+            nonce_chunk ? nonce_chunk : 4 * gs->iterations, gs->iterations,
+            gs->iterations);
+    if (verbose > 1)
+        printf("Device %u: nonces per chunk: 0x%x\n", devi, gs->sched.chunk);
+}
+
+void sweep_threads_per_grp(gpu_state_t *gs);
+
+/*
+ * Compile pool job preparing a GPU: picks its number of threads per group if
+ * it was not given, then prepares the kernel it uses for all work items.
+ */
+void compile_device_kernel(void *arg)
+{
+    gpu_state_t *gs = arg;
+    if (tune_threads_per_grp)
+        sweep_threads_per_grp(gs);
+    init_sched(gs->devi, gs);
+    if (kernel_mode == KERNEL_CBUF)
+      {
+        if (verbose)
+            printf("Device %u: compiling kernel\n", gs->devi);
+        gs->img = compile_kernel(NULL, gs->target, gs->threads_per_grp, true);
+      }
+    else if (kernel_mode == KERNEL_PATCH)
+        prepare_patch(gs);
+}
+
+/*
+ * Opens the device. Its kernel is compiled in the background by the compile
+ * pool, and its first work item is acquired by create_next_work_item once
+ * this is done.
+ */
 void prepare_run(CALuint devi, gpu_state_t *gs)
 {
+    gs->have_run = false;
+    gs->run_buf = -1;
+    gs->last_buf = NR_STATE_BUFS - 1;
+    hash_rate_init(&gs->rate);
+    gs->mhashpsec = gs->window_mhashpsec = 0;
+    pthread_mutex_init(&gs->ahead_lock, NULL);
+    gs->ahead = calloc(work_ahead, sizeof (*gs->ahead));
+    if (!gs->ahead)
+        perror("calloc"), exit(1);
+    gs->nr_ahead = 0;
+    if (gs->cpu)
+      {
+        // one cache line per thread state, so workers do not share lines
+        for (int b = 0; b < NR_STATE_BUFS; b++)
+          {
+            if (posix_memalign((void **)&gs->buf[b].host, 64,
+                        gs->nr_threads * sizeof (thread_state_t)))
+                perror("posix_memalign"), exit(1);
+            memset(gs->buf[b].host, 0,
+                    gs->nr_threads * sizeof (thread_state_t));
+            if (compact_results &&
+                    !(gs->buf[b].hostResults = calloc(1, sizeof (results_t))))
+                perror("calloc"), exit(1);
+          }
+        init_sched(devi, gs);
+        return;
+      }
     // open device
     if (CAL_RESULT_OK != calDeviceOpen(&gs->device, devi))
         fatal("calDeviceOpen");
     if (CAL_RESULT_OK != calCtxCreate(&gs->ctx, gs->device))
         fatal("calCtxCreate");
-    gs->have_run = false;
-    gs->last_mhashpsec = 0;
-    create_next_work_item(devi, gs);
+    // the scheduler is set up by this job too, the number of threads of the
+    // device may change until then
+    compile_pool_submit(compile_pool, compile_device_kernel, gs, 0);
 }
 
 /*
- * Shift the next_* variable representing the next work item to the current
- * variables, and notify the controller thread so it can acquire and prepare
- * the next work item.
+ * Make the device scan a carried-over work item if there is one it can scan,
+ * and otherwise the oldest work item prepared ahead, in which case the
+ * controller thread is notified so it can acquire and prepare another one.
  */
 void shift_to_next_work(CALuint devi, gpu_state_t *gs)
 {
-    if (!gs->next_img)
+    work_item_t *w = take_carried(gs);
+    if (w)
+      {
+        if (verbose)
+            printf("Device %d: resuming carried-over work\n", devi);
+        gs->cur = w;
+        nonce_sched_reset(&gs->sched, w->left, w->nr_left);
+        free(w->left);
+        w->left = NULL;
+        w->nr_left = 0;
+        return;
+      }
+    // the scheduler is only reset after, so that the lead times of the
+    // items requested count what is left of the current one
+    if (!(w = refresh_ahead(devi, gs, true)))
       {
 	printf("Device %d: getwork was not quick enough - waiting a bit...\n",
 		devi);
 	// wait for the controller thread to prepare work
-	while (!gs->next_img)
+	while (!(w = refresh_ahead(devi, gs, true)))
 	  {
 	    struct timespec req = { .tv_sec = 0, .tv_nsec = 1e6 };
 	    nanosleep(&req, NULL);
 	  }
 	printf("Device %d: getwork returned - resuming\n", devi);
       }
-    gs->img = gs->next_img;
-    gs->next_img = NULL;
-    memcpy(gs->datawords, gs->next_datawords, sizeof (gs->datawords));
-    memcpy(gs->midstate, gs->next_midstate, sizeof (gs->midstate));
-    // tell the controller thread to prepare the next work item
-    instr_t *i = malloc(sizeof (*i));
-    if (!i)
-        perror("malloc instruction"), exit(1);
-    i->id = CREATE_NEXT_WORK_ITEM;
-    i->devi = devi;
-    i->gs = gs;
-    if (-1 == write(pipefd[1], &i, sizeof (i)))
-	perror("shift_to_next_work: write"), exit(1);
+    gs->cur = w;
+    nonce_sched_reset(&gs->sched, NULL, 0);
 }
 
-void set_local_res_mem(CALdevice device, CALcontext ctx, CALmodule module,
+void alloc_local_res_mem(CALdevice device, CALcontext ctx,
         CALresource *res, CALuint flags,
-        CALmem *mem, const void *data, unsigned length, const char *param_name)
+        CALmem *mem, const void *data, unsigned length)
 {
     /* About calResAllocLocal2D: There are some performance implications when
      * width is not a multiple of 64 for R6xx GPUs. Neither the width nor the
@@ -420,44 +926,161 @@ void set_local_res_mem(CALdevice device, CALcontext ctx, CALmodule module,
         if (CAL_RESULT_OK != calResUnmap(*res))
             fatal("calResUnmap");
       }
-    // bind to appropriate parameter
+}
+
+/*
+ * Allocates a global buffer of length bytes in the remote memory of
+ * state_mem and maps it in *host until it is freed. Returns false if the
+ * device has not enough of it left.
+ */
+bool alloc_remote_res_mem(gpu_state_t *gs, CALresource *res, CALmem *mem,
+        void **host, unsigned length)
+{
+    CALuint pitch;
+    CALuint flags = CAL_RESALLOC_GLOBAL_BUFFER;
+    if (state_mem == MEM_CACHED)
+        flags |= CAL_RESALLOC_CACHEABLE;
+    if (CAL_RESULT_OK != calResAllocRemote1D(res, &gs->device, 1,
+                length / 4, CAL_FORMAT_UNORM_INT32_1, flags))
+      {
+        printf("Device %u: cannot allocate remote memory (%s), falling back "
+                "to local memory\n", gs->devi, calGetErrorString());
+        gs->remote = false;
+        return false;
+      }
+    if (CAL_RESULT_OK != calCtxGetMem(mem, gs->ctx, *res))
+        fatal("calCtxGetMem");
+    if (CAL_RESULT_OK != calResMap((CALvoid **)host, &pitch, *res, 0))
+        fatal("calResMap");
+    return true;
+}
+
+void bind_mem(CALcontext ctx, CALmodule module, CALmem mem,
+        const char *param_name)
+{
     CALname n;
     if (CAL_RESULT_OK != calModuleGetName(&n, ctx, module, param_name))
         fatal("calModuleGetName");
-    if (CAL_RESULT_OK != calCtxSetMem(ctx, n, *mem))
+    if (CAL_RESULT_OK != calCtxSetMem(ctx, n, mem))
         fatal("calCtxSetMem");
 }
 
-void load_module_data(gpu_state_t *gs)
+/**
+ * Allocates the resources of the device, once: they do not depend on the
+ * work item, nor on the module it is scanned with.
+ */
+void alloc_device_res(gpu_state_t *gs)
+{
+    if (gs->cpu)
+        return;
+    // global buffers "g[]" (gs->nr_threads * size of thread state)
+    if (verbose)
+        printf("Initializing global buffers\n");
+    for (int b = 0; b < NR_STATE_BUFS; b++)
+        if (!gs->remote || !alloc_remote_res_mem(gs, &gs->buf[b].res,
+                    &gs->buf[b].mem, (void **)&gs->buf[b].host,
+                    gs->nr_threads * sizeof (thread_state_t)))
+            alloc_local_res_mem(gs->device, gs->ctx,
+                    &gs->buf[b].res, CAL_RESALLOC_GLOBAL_BUFFER,
+                    &gs->buf[b].mem, NULL,
+                    gs->nr_threads * sizeof (thread_state_t));
+
+    // result buffers "uav1", see results_t
+    if (compact_results)
+      {
+        results_t empty = { .count = 0 };
+        for (int b = 0; b < NR_STATE_BUFS; b++)
+            if (gs->remote && alloc_remote_res_mem(gs, &gs->buf[b].resultsRes,
+                        &gs->buf[b].resultsMem, (void **)&gs->buf[b].hostResults,
+                        sizeof (empty)))
+                *gs->buf[b].hostResults = empty;
+            else
+                alloc_local_res_mem(gs->device, gs->ctx,
+                        &gs->buf[b].resultsRes, CAL_RESALLOC_GLOBAL_BUFFER,
+                        &gs->buf[b].resultsMem, &empty, sizeof (empty));
+      }
+
+    // SHA-256 cube roots of the first 64 primes "cb0" (64 4-byte values)
+    if (verbose)
+        printf("Initializing cube root constants\n");
+    alloc_local_res_mem(gs->device, gs->ctx,
+            &gs->constRes, 0,
+            &gs->constMem, sha256_k, 64 * 4);
+
+    // per-work values "cb1" (32 4-byte values), see set_work_constants
+    if (kernel_mode == KERNEL_CBUF)
+        alloc_local_res_mem(gs->device, gs->ctx,
+                &gs->workRes, 0,
+                &gs->workMem, NULL, 32 * 4);
+}
+
+void free_local_res_mem(CALcontext ctx, CALmem mem, CALresource res)
+{
+    if (CAL_RESULT_OK != calCtxReleaseMem(ctx, mem))
+        fatal("calCtxReleaseMem");
+    if (CAL_RESULT_OK != calResFree(res))
+        fatal("calResFree");
+}
+
+void free_device_res(gpu_state_t *gs)
+{
+    if (gs->cpu)
+        return;
+    if (kernel_mode == KERNEL_CBUF)
+        free_local_res_mem(gs->ctx, gs->workMem, gs->workRes);
+    free_local_res_mem(gs->ctx, gs->constMem, gs->constRes);
+    for (int b = 0; b < NR_STATE_BUFS; b++)
+      {
+        // remote memory stays mapped until then
+        if (gs->buf[b].host && CAL_RESULT_OK != calResUnmap(gs->buf[b].res))
+            fatal("calResUnmap");
+        gs->buf[b].host = NULL;
+        free_local_res_mem(gs->ctx, gs->buf[b].mem, gs->buf[b].res);
+        if (!compact_results)
+            continue;
+        if (gs->buf[b].hostResults &&
+                CAL_RESULT_OK != calResUnmap(gs->buf[b].resultsRes))
+            fatal("calResUnmap");
+        gs->buf[b].hostResults = NULL;
+        free_local_res_mem(gs->ctx, gs->buf[b].resultsMem,
+                gs->buf[b].resultsRes);
+      }
+}
+
+/**
+ * Loads the module of img, that of the device (with KERNEL_CBUF) or of its
+ * current work item, and binds the resources of the device to it.
+ */
+void load_module(gpu_state_t *gs, CALimage img)
 {
     CALfunc entry;
 
+    if (gs->cpu)
+        return;
     // load module, get entry point
-    if (CAL_RESULT_OK != calModuleLoad(&gs->module, gs->ctx, gs->img))
+    if (CAL_RESULT_OK != calModuleLoad(&gs->module, gs->ctx, img))
         fatal("calModuleLoad");
     if (CAL_RESULT_OK != calModuleGetEntry(&entry, gs->ctx, gs->module,
                 "main"))
         fatal("calModuleGetEntry");
 
-    // global buffer "g[]" (gs->nr_threads * size of thread state)
-    if (verbose)
-        printf("Initializing global buffer\n");
-    set_local_res_mem(gs->device, gs->ctx, gs->module,
-            &gs->globalRes, CAL_RESALLOC_GLOBAL_BUFFER,
-            &gs->globalMem, NULL,
-            gs->nr_threads * sizeof (thread_state_t), "g[]");
-
-    // SHA-256 cube roots of the first 64 primes "cb0" (64 4-byte values)
-    if (verbose)
-        printf("Initializing cube root constants\n");
-    set_local_res_mem(gs->device, gs->ctx, gs->module,
-            &gs->constRes, 0,
-            &gs->constMem, k_constants, 64 * 4, "cb0");
+    // the table of each run is bound to "g[]" by threads_start, and its
+    // result buffer to "uav1"
+    if (CAL_RESULT_OK != calModuleGetName(&gs->globalName, gs->ctx,
+                gs->module, "g[]"))
+        fatal("calModuleGetName");
+    if (compact_results && CAL_RESULT_OK != calModuleGetName(
+                &gs->resultsName, gs->ctx, gs->module, "uav1"))
+        fatal("calModuleGetName");
+    bind_mem(gs->ctx, gs->module, gs->constMem, "cb0");
+    if (kernel_mode == KERNEL_CBUF)
+        bind_mem(gs->ctx, gs->module, gs->workMem, "cb1");
 
     // init program grid
     CALprogramGrid pg = {
         .func = entry,
-        .gridBlock = { .width = threads_per_grp, .height = 1, .depth = 1 },
+        .gridBlock = { .width = gs->threads_per_grp, .height = 1,
+            .depth = 1 },
         .gridSize = { .width = gs->nr_simds, .height = 1, .depth = 1 },
         .flags = 0
     };
@@ -465,40 +1088,53 @@ void load_module_data(gpu_state_t *gs)
     gs->e = 0;
 }
 
-void free_local_res_mem(CALcontext ctx, CALmem mem, CALresource res)
+void unload_module(gpu_state_t *gs)
 {
-    if (CAL_RESULT_OK != calCtxReleaseMem(ctx, mem))
-        fatal("calCtxReleaseMem");
-    if (CAL_RESULT_OK != calResFree(res))
-        fatal("calResFree");
+    if (gs->cpu)
+        return;
+    // the image belongs to the device or to the work item
+    if (CAL_RESULT_OK != calModuleUnload(gs->ctx, gs->module))
+        fatal("calModuleUnload");
 }
 
-void unload_module_data(gpu_state_t *gs)
+/**
+ * With KERNEL_CBUF, switches the loaded module to the current work item by
+ * rewriting its per-work values.
+ */
+void set_work_constants(gpu_state_t *gs)
 {
-    free_local_res_mem(gs->ctx, gs->constMem, gs->constRes);
-    free_local_res_mem(gs->ctx, gs->globalMem, gs->globalRes);
-    // unload module
-    if (CAL_RESULT_OK != calModuleUnload(gs->ctx, gs->module))
-        fatal("calModuleUnload");
-    // free the image
-    if (CAL_RESULT_OK != calclFreeImage(gs->img))
-        fatal("calclFreeImage");
+    uint32_t *mapped;
+    CALuint pitch;
+    if (gs->cpu)
+        return;
+    if (CAL_RESULT_OK != calResMap((CALvoid**)&mapped, &pitch, gs->workRes, 0))
+        fatal("calResMap");
+    work_constants(mapped, &gs->cur->work);
+    if (CAL_RESULT_OK != calResUnmap(gs->workRes))
+        fatal("calResUnmap");
 }
 
 /**
  * Returns true iff the threads are currently running. Returns false
- * if they have never been started of if they completed work.
+ * if they have not been started of if they completed work.
  */
 bool threads_running(gpu_state_t *gs)
 {
-    if (!gs->have_run)
-        // threads have never been started
+    if (gs->run_buf < 0)
+        // no run in flight
+        return false;
+    if (gs->cpu)
+      {
+        if (cpu_pool_busy(gs->pool))
+            return true;
+        gettimeofday(&gs->buf[gs->run_buf].tv_end, NULL);
         return false;
+      }
     CALresult res;
     res = calCtxIsEventDone(gs->ctx, gs->e);
     if (res == CAL_RESULT_OK)
       {
-        gettimeofday(&gs->tv_end, NULL);
+        gettimeofday(&gs->buf[gs->run_buf].tv_end, NULL);
         return false;
       }
     else if (res != CAL_RESULT_PENDING)
@@ -506,17 +1142,51 @@ bool threads_running(gpu_state_t *gs)
     return true;
 }
 
+/*
+ * Blocks until the threads of the device are done (if they were started).
+ */
+void threads_wait(gpu_state_t *gs)
+{
+    if (gs->run_buf < 0)
+        return;
+    if (gs->cpu)
+        cpu_pool_wait(gs->pool);
+    else if (cal_wait_events)
+      {
+        CALresult res = calCtxWaitForEvents(gs->ctx, &gs->e, 1, 0);
+        if (res == CAL_RESULT_NOT_SUPPORTED)
+          {
+            if (verbose)
+                printf("calCtxWaitForEvents not supported, polling events\n");
+            cal_wait_events = false;
+          }
+        else if (res != CAL_RESULT_OK)
+            fatal("calCtxWaitForEvents");
+      }
+    // the device is only polled by its own thread, so this can be often
+    while (threads_running(gs))
+      {
+        struct timespec req = { .tv_sec = 0, .tv_nsec = 50e3 };
+        nanosleep(&req, NULL);
+      }
+    gs->run_buf = -1;
+}
+
 void show_global_stats(gpu_state_t *gs_base, CALuint nr_devs)
 {
     CALuint devi;
-    int global_mhashpsec = 0;
+    double global_mhashpsec = 0, global_window_mhashpsec = 0;
     for (devi = 0; devi < nr_devs; devi++)
       {
 	if (!gs_base[devi].used)
 	    continue;
-        global_mhashpsec += gs_base[devi].last_mhashpsec;
+        global_mhashpsec += gs_base[devi].mhashpsec;
+        global_window_mhashpsec += gs_base[devi].window_mhashpsec;
+        if (verbose && gs_base[devi].cpu)
+            cpu_pool_show_rates(gs_base[devi].pool);
       }
-    printf("Overall rate: %u Mhash/sec...", global_mhashpsec);
+    printf("Overall rate: %.0f Mhash/sec (%.0f over %.0f s)...",
+            global_mhashpsec, global_window_mhashpsec, HASH_RATE_WINDOW);
     if (verbose)
         printf("\n");
     else {
@@ -525,20 +1195,37 @@ void show_global_stats(gpu_state_t *gs_base, CALuint nr_devs)
     }
 }
 
-void show_stats(CALuint devi, gpu_state_t *gs)
+double tv_seconds(const struct timeval *tv)
+{
+    return tv->tv_sec + tv->tv_usec / 1e6;
+}
+
+/*
+ * Returns the duration of the last run of a state table, in seconds.
+ */
+double run_time(const state_buf_t *buf)
+{
+    return tv_seconds(&buf->tv_end) - tv_seconds(&buf->tv_start);
+}
+
+/*
+ * Accounts for the nonces scanned by the run of table b, once analyzed.
+ */
+void show_stats(CALuint devi, gpu_state_t *gs, int b)
 {
-    long long ms0 = gs->tv_start.tv_sec * 1000 + gs->tv_start.tv_usec / 1000;
-    long long ms1 = gs->tv_end.tv_sec * 1000 + gs->tv_end.tv_usec / 1000;
-    int mhashpsec = (int)
-        ((float)ELM_PER_THREAD // nr of hashes verified per thread per iteration
-         * iterations // nr of iterations of the main loop for each thread
-         * gs->nr_threads // nr of threads
-         * 1000 / (ms1 - ms0) // hash/period_of_time converted to hash/sec
-         / 1e6); // converted to Mhash/sec
+    const state_buf_t *buf = gs->buf + b;
+    double t = run_time(buf);
+    hash_rate_add(&gs->rate, buf->scanned, tv_seconds(&buf->tv_start),
+            tv_seconds(&buf->tv_end));
+    gs->mhashpsec = gs->rate.ewma / 1e6;
+    gs->window_mhashpsec = hash_rate_window(&gs->rate,
+            tv_seconds(&buf->tv_end)) / 1e6;
     if (verbose)
-        printf("Device %d: execution time %lld ms (%u Mhash/sec)\n",
-                devi, ms1 - ms0, mhashpsec);
-    gs->last_mhashpsec = mhashpsec;
+        printf("Device %d: execution time %.0f ms, %llu nonces (%.0f "
+                "Mhash/sec, %.0f average, %.0f over %.0f s)\n", devi,
+                t * 1e3, (unsigned long long)buf->scanned,
+                t > 0 ? buf->scanned / t / 1e6 : 0, gs->mhashpsec,
+                gs->window_mhashpsec, HASH_RATE_WINDOW);
 }
 
 /*
@@ -562,36 +1249,180 @@ void validate_candidate(gpu_state_t *gs, CALuint devi, int t, int e,
         perror("malloc instruction"), exit(1);
     i->id = VERIFY_POTENTIAL_FIND;
     i->devi = devi;
-    memcpy(i->datawords, gs->datawords, 128);
+    memcpy(i->datawords, gs->cur->datawords, 128);
     i->nonce = nonce;
     if (-1 == write(pipefd[1], &i, sizeof (i)))
 	perror("validate_candidate: write"), exit(1);
 }
 
 /**
- * Analyze current results from the global buffer (if threads have
- * run at least once). And prepare next batch of work.
+ * Maps state table b of the device in host memory, unless it is there
+ * already (CPU device, or remote memory).
  */
-void threads_analyze_and_prepare(CALuint devi, gpu_state_t *gs)
+void *map_state(gpu_state_t *gs, int b)
 {
-    uint8_t *ptr = NULL;
-    // a single variable is used to determine if new work should be fetched,
-    // which means when 1 elm of 1 thread finds a potential nonce solving the
-    // block, all threads will start on new work on the next run
-    bool ready_for_new_work = false;
-    if (!gs->have_run)
+    void *ptr;
+    CALuint pitch = 0;
+    if (gs->buf[b].host)
+        return gs->buf[b].host;
+    if (CAL_RESULT_OK != calResMap((CALvoid**)&ptr, &pitch, gs->buf[b].res, 0))
+        fatal("calResMap");
+    return ptr;
+}
+
+void unmap_state(gpu_state_t *gs, int b, const char *err_msg)
+{
+    if (gs->buf[b].host)
+        return;
+    if (CAL_RESULT_OK != calResUnmap(gs->buf[b].res))
+        fatal(err_msg);
+}
+
+/*
+ * A run scans at most the iterations its table was seeded with: the scheduler
+ * must not let other elements steal these nonces meanwhile.
+ */
+void set_max_run(gpu_state_t *gs)
+{
+    unsigned n = gs->iterations;
+    for (int b = 0; b < NR_STATE_BUFS; b++)
+        if (gs->buf[b].iterations > n)
+            n = gs->buf[b].iterations;
+    gs->sched.max_run = n;
+}
+
+/*
+ * Sets the iterations of the next runs of the device, and the sizes the
+ * scheduler derives from them.
+ */
+void set_iterations(gpu_state_t *gs, unsigned n)
+{
+    gs->iterations = n;
+    gs->sched.chunk = nonce_chunk ? nonce_chunk : 4 * n;
+    gs->sched.min_split = n;
+    set_max_run(gs);
+}
+
+/**
+ * Writes the nonce ranges given by the scheduler to state table b, along with
+ * the iterations of the next runs, which is then started by
+ * threads_start_next unless all its elements are parked. With
+ * compact_results, the table is left alone if the device already has these
+ * ranges and iterations.
+ */
+void set_ranges(gpu_state_t *gs, int b)
+{
+    const int nr_elms = gs->nr_threads * ELM_PER_THREAD;
+    const nonce_range_t *ranges = gs->sched.ranges + b * nr_elms;
+    gs->buf[b].seeded = false;
+    for (int i = b * nr_elms; i < (b + 1) * nr_elms; i++)
+        if (!gs->sched.parked[i])
+            gs->buf[b].seeded = true;
+    if (compact_results)
       {
-        ready_for_new_work = true;
-        goto new_work;
+        if (gs->buf[b].iterations == gs->iterations &&
+                !memcmp(gs->buf[b].ranges, ranges, nr_elms * sizeof (*ranges)))
+            return;
+        memcpy(gs->buf[b].ranges, ranges, nr_elms * sizeof (*ranges));
+      }
+    gs->buf[b].iterations = gs->iterations;
+    set_max_run(gs);
+    uint8_t *ptr = map_state(gs, b);
+    for (int t = 0; t < gs->nr_threads; t++)
+      {
+        thread_state_t *ts = (thread_state_t *)ptr + t;
+        for (int e = 0; e < ELM_PER_THREAD; e++)
+          {
+            elm_state_t *elm = (elm_state_t *)ts + e;
+            int i = b * nr_elms + t * ELM_PER_THREAD + e;
+            const nonce_range_t *r = gs->sched.ranges + i;
+            elm->status = s_searching;
+            elm->cur_nonce = r->cur;
+            elm->end_nonce = r->end;
+            elm->iterations = gs->iterations;
+          }
       }
-    // map
+    unmap_state(gs, b, "calResUnmap 2");
+}
+
+results_t *map_results(gpu_state_t *gs, int b)
+{
+    void *ptr;
     CALuint pitch = 0;
-    if (CAL_RESULT_OK != calResMap((CALvoid**)&ptr, &pitch, gs->globalRes, 0))
+    if (gs->buf[b].hostResults)
+        return gs->buf[b].hostResults;
+    if (CAL_RESULT_OK != calResMap((CALvoid**)&ptr, &pitch,
+                gs->buf[b].resultsRes, 0))
         fatal("calResMap");
-    // analyze results if we have some, ie. if the threads have been started
-    show_stats(devi, gs);
+    return ptr;
+}
+
+void unmap_results(gpu_state_t *gs, int b)
+{
+    if (gs->buf[b].hostResults)
+        return;
+    if (CAL_RESULT_OK != calResUnmap(gs->buf[b].resultsRes))
+        fatal("calResUnmap");
+}
+
+/**
+ * threads_analyze with compact_results: only the result buffer of table b is
+ * read. The progress of the elements is known without reading the table, as
+ * each of them scans exactly min(iterations, nonces left) per run.
+ */
+void threads_analyze_compact(CALuint devi, gpu_state_t *gs, int b)
+{
+    const int nr_elms = gs->nr_threads * ELM_PER_THREAD;
+    results_t *res = map_results(gs, b);
+    if (verbose > 1)
+        printf(" Result buffer %d: %u candidates\n", b, res->count);
+    if (res->count > RESULT_SLOTS)
+        fprintf(stderr, "Device %u: result buffer full, %u candidates "
+                "overwritten in its last slot\n", devi,
+                res->count - RESULT_SLOTS);
+    for (unsigned c = 0; c < res->count && c < RESULT_SLOTS; c++)
+      {
+        const candidate_t *f = res->found + c;
+        validate_candidate(gs, devi, f->elm / ELM_PER_THREAD,
+                f->elm % ELM_PER_THREAD, f->nonce);
+      }
+    res->count = 0;
+    unmap_results(gs, b);
+    gs->buf[b].scanned = gs->buf[b].full = 0;
+    for (int k = 0; k < nr_elms; k++)
+      {
+        int i = b * nr_elms + k;
+        const nonce_range_t *r = gs->sched.ranges + i;
+        if (gs->sched.parked[i])
+            continue;
+        uint64_t n = r->end - r->cur;
+        if (n > gs->buf[b].iterations)
+            n = gs->buf[b].iterations;
+        gs->buf[b].scanned += n;
+        gs->buf[b].full += gs->buf[b].iterations;
+        nonce_sched_progress(&gs->sched, i, r->cur + n);
+        gs->buf[b].ranges[k].cur = r->cur;
+      }
+    show_stats(devi, gs, b);
+}
+
+/**
+ * Analyzes the results of the run of state table b: sends the candidates
+ * found to the controller thread and reports the progress of the elements to
+ * the scheduler.
+ */
+void threads_analyze(CALuint devi, gpu_state_t *gs, int b)
+{
+    const int nr_elms = gs->nr_threads * ELM_PER_THREAD;
+    if (compact_results)
+      {
+        threads_analyze_compact(devi, gs, b);
+        return;
+      }
+    uint8_t *ptr = map_state(gs, b);
+    gs->buf[b].scanned = gs->buf[b].full = 0;
     if (verbose > 1)
-        printf(" Global buffer for first and last threads:\n");
+        printf(" State table %d for first and last threads:\n", b);
     for (int t = 0; t < gs->nr_threads; t++)
       {
         thread_state_t *ts = (thread_state_t *)ptr + t;
@@ -600,11 +1431,15 @@ void threads_analyze_and_prepare(CALuint devi, gpu_state_t *gs)
         for (int e = 0; e < ELM_PER_THREAD; e++)
           {
             elm_state_t *elm = (elm_state_t *)ts + e;
+            int i = b * nr_elms + t * ELM_PER_THREAD + e;
             if (verbose > 1 && (t <= 0 || t == gs->nr_threads - 1))
-                printf("    elm %d: %02x(%02x%02x%02x) %08x %08x %08x\n",
+                printf("    elm %d: %02x(%02x%02x%02x) %08x %08x %08x%s\n",
                         e, elm->status,
                         elm->_unused0[0], elm->_unused0[1], elm->_unused0[2],
-                        elm->cur_nonce, elm->end_nonce, elm->_unused1);
+                        elm->cur_nonce, elm->end_nonce, elm->iterations,
+                        gs->sched.parked[i] ? " parked" : "");
+            if (gs->sched.parked[i])
+                continue; // scanning a dummy range, ignore its results
             if (elm->status == s_searching)
                 (void)0; // still searching this work unit
             else if (elm->status == s_found)
@@ -617,60 +1452,315 @@ void threads_analyze_and_prepare(CALuint devi, gpu_state_t *gs)
                             devi, t, e);
                 validate_candidate(gs, devi, t, e, elm->cur_nonce - 1);
                 // Regardless of whether it is valid or not, continue
-                // processing were we left at. Note that we need special
-                // handling if the nonce was the last one to be verified.
-                if (elm->cur_nonce == elm->end_nonce)
-                    ready_for_new_work = true;
+                // processing were we left at. If the nonce was the last one
+                // of its range, the scheduler gives the element more.
               }
             else if (elm->status == s_finished)
-              {
-                // finished searching all nonce, try next one
-                ready_for_new_work = true;
-              }
+                (void)0; // finished its range, the scheduler gives it more
             else
                 fprintf(stderr, "*bug*: invalid status for GPU %d thread %d "
                         "elm %d: %02x\n", devi, t, e, elm->status), exit(1);
+            gs->buf[b].scanned +=
+                (uint32_t)(elm->cur_nonce - gs->sched.ranges[i].cur);
+            gs->buf[b].full += gs->buf[b].iterations;
+            nonce_sched_progress(&gs->sched, i, elm->cur_nonce);
           }
       }
-new_work:
-    if (ptr)
-        if (CAL_RESULT_OK != calResUnmap(gs->globalRes))
-            fatal("calResUnmap 1");
-    if (ready_for_new_work)
-      {
-        if (gs->have_run)
-            unload_module_data(gs);
-        shift_to_next_work(devi, gs);
-        load_module_data(gs);
-        if (CAL_RESULT_OK !=
-                calResMap((CALvoid**)&ptr, &pitch, gs->globalRes, 0))
-            fatal("calResMap");
-        uint32_t nonces_per_elm =
-            (uint32_t)-1 / (gs->nr_threads * ELM_PER_THREAD);
-        uint32_t n = 0;
-        //n = 0xd3fb29;
-        if (verbose > 1)
-            printf("Nonces per elm: 0x%x\n", nonces_per_elm);
-        for (int t = 0; t < gs->nr_threads; t++)
+    unmap_state(gs, b, "calResUnmap 1");
+    show_stats(devi, gs, b);
+}
+
+/*
+ * Moves the iterations of the next runs of the device toward those that would
+ * make them last tune_run_ms, from the duration of the run of table b. Runs
+ * where many elements stopped early, at the end of a work item, tell nothing.
+ */
+void tune_iterations(CALuint devi, gpu_state_t *gs, int b)
+{
+    const state_buf_t *buf = gs->buf + b;
+    double t = run_time(buf);
+    if (!tune_run_ms || buf->scanned < buf->full / 4 * 3 || t <= 0)
+        return;
+    // half way only, and at most by half or double at once: the duration of
+    // a single run is noisy
+    double n = buf->iterations *
+        (1 + fmin(fmax(tune_run_ms / 1e3 / t, .5), 2)) / 2;
+    n = fmin(fmax(n, min_iterations), max_iterations);
+    // small changes are not worth rewriting the tables with compact_results
+    if (fabs(n - gs->iterations) < gs->iterations / 10.)
+        return;
+    set_iterations(gs, n);
+    if (verbose)
+        printf("Device %u: %u iterations per run\n", devi, gs->iterations);
+}
+
+/**
+ * Analyze the results of the run of state table b (if threads have run at
+ * least once), and seed it for a next run. The other table may be running
+ * meanwhile: it is waited for only when the device moves to new work.
+ */
+void threads_analyze_and_prepare(CALuint devi, gpu_state_t *gs, int b)
+{
+    const int nr_elms = gs->nr_threads * ELM_PER_THREAD;
+    // the device moves to new work when the scheduler has no nonce left to
+    // give to any element, ie. when all of them are parked, or as soon as
+    // one is parked if what is left is worth a run of a device: it is then
+    // carried over to the next device asking for work
+    uint64_t carry_over_min = (uint64_t)nr_elms * gs->iterations;
+    if (gs->have_run)
+      {
+        // replace stale work items early, not when the device needs them
+        refresh_ahead(devi, gs, false);
+        threads_analyze(devi, gs, b);
+        tune_iterations(devi, gs, b);
+        if (nonce_sched_refill(&gs->sched, b * nr_elms, nr_elms) &&
+                !(gs->sched.nr_parked &&
+                    nonce_sched_left(&gs->sched) >= carry_over_min))
           {
-            thread_state_t *ts = (thread_state_t *)ptr + t;
-            for (int e = 0; e < ELM_PER_THREAD; e++)
-              {
-                elm_state_t *elm = (elm_state_t *)ts + e;
-                elm->status = s_searching;
-                elm->cur_nonce = n;
-                elm->end_nonce = (n += nonces_per_elm);
-                elm->_unused1 = 0;
-              }
+            set_ranges(gs, b);
+            return;
+          }
+        // this may be the end of the work item: complete the other run, so
+        // as to decide with all the elements reporting their progress
+        int other = gs->run_buf;
+        if (other >= 0)
+          {
+            threads_wait(gs);
+            threads_analyze(devi, gs, other);
+          }
+        if (!nonce_sched_refill(&gs->sched, 0, NR_STATE_BUFS * nr_elms))
+            (void)0; // all scanned
+        else if (gs->sched.nr_parked &&
+                nonce_sched_left(&gs->sched) >= carry_over_min)
+            gs->cur->nr_left =
+                nonce_sched_take_left(&gs->sched, &gs->cur->left);
+        else
+          {
+            for (int i = 0; i < NR_STATE_BUFS; i++)
+                set_ranges(gs, i);
+            return;
           }
-        if (CAL_RESULT_OK != calResUnmap(gs->globalRes))
-            fatal("calResUnmap 2");
       }
+    // new work, nothing is running
+    work_item_t *prev = gs->cur;
+    // the resources stay allocated and, with KERNEL_CBUF, the module stays
+    // loaded: only cb1 changes
+    bool reload = !gs->have_run || kernel_mode != KERNEL_CBUF;
+    if (!gs->have_run)
+        alloc_device_res(gs);
+    else if (reload)
+        unload_module(gs);
+    shift_to_next_work(devi, gs);
+    // queued only now, so that this device does not take it back
+    if (prev && prev->nr_left)
+        queue_carried(devi, prev);
+    else if (prev)
+        work_item_release(prev);
+    if (reload)
+        load_module(gs, kernel_mode == KERNEL_CBUF ? gs->img : gs->cur->img);
+    if (kernel_mode == KERNEL_CBUF)
+        set_work_constants(gs);
+    nonce_sched_refill(&gs->sched, 0, NR_STATE_BUFS * nr_elms);
+    for (int i = 0; i < NR_STATE_BUFS; i++)
+        set_ranges(gs, i);
 }
 
-void threads_start(gpu_state_t *gs)
+/*
+ * Returns true iff element e of thread t of the running table is parked. Its
+ * dummy range 0-0 is a full 2^32 range the host would ignore, so the CPU
+ * device does not scan it. The flags of the running table do not change
+ * before it completes: meanwhile the host only refills the other one.
+ */
+bool cpu_elm_parked(const gpu_state_t *gs, int t, int e)
+{
+    const int nr_elms = gs->nr_threads * ELM_PER_THREAD;
+    return gs->sched.parked[gs->run_buf * nr_elms + t * ELM_PER_THREAD + e];
+}
+
+/*
+ * cpu_scan_worker with compact_results, like the compact kernel: each element
+ * scans min(iterations of the table, nonces left), and the candidates are
+ * appended to the result buffer.
+ */
+uint64_t cpu_scan_compact(gpu_state_t *gs, int t)
 {
-    gettimeofday(&gs->tv_start, NULL);
+    state_buf_t *buf = gs->buf + gs->run_buf;
+    results_t *res = buf->hostResults;
+    uint64_t hashes = 0;
+    for (int e = 0; e < ELM_PER_THREAD; e++)
+      {
+        elm_state_t *elm = buf->host[t].elm + e;
+        if (cpu_elm_parked(gs, t, e))
+            continue;
+        uint32_t cur_nonce = elm->cur_nonce;
+        uint32_t n = elm->end_nonce - cur_nonce;
+        if (n > buf->iterations)
+            n = buf->iterations;
+        while (n)
+          {
+            uint32_t prev = cur_nonce;
+            bool found = cpu_scan(&gs->cur->work, &cur_nonce, elm->end_nonce, n);
+            n -= cur_nonce - prev;
+            hashes += cur_nonce - prev;
+            if (!found)
+                continue;
+            uint32_t slot = __sync_fetch_and_add(&res->count, 1);
+            if (slot >= RESULT_SLOTS)
+                slot = RESULT_SLOTS - 1;
+            res->found[slot].nonce = cur_nonce - 1;
+            res->found[slot].elm = t * ELM_PER_THREAD + e;
+          }
+        elm->cur_nonce = cur_nonce;
+      }
+    return hashes;
+}
+
+/*
+ * Does on the host CPU what one run of the kernel does for thread t on a GPU:
+ * hash up to the iterations of the table nonces of each of its elements and
+ * update their state accordingly. Parked elements are left alone. Returns the
+ * number of hashes done.
+ */
+uint64_t cpu_scan_worker(void *arg, int t)
+{
+    gpu_state_t *gs = arg;
+    if (compact_results)
+        return cpu_scan_compact(gs, t);
+    state_buf_t *buf = gs->buf + gs->run_buf;
+    thread_state_t *ts = buf->host + t;
+    uint64_t hashes = 0;
+    for (int e = 0; e < ELM_PER_THREAD; e++)
+      {
+        elm_state_t *elm = (elm_state_t *)ts + e;
+        if (cpu_elm_parked(gs, t, e))
+            continue;
+        uint32_t cur_nonce = elm->cur_nonce;
+        if (cpu_scan(&gs->cur->work, &cur_nonce, elm->end_nonce,
+                    buf->iterations))
+            elm->status = s_found;
+        else if (cur_nonce == elm->end_nonce)
+            elm->status = s_finished;
+        else
+            elm->status = s_searching;
+        hashes += (uint32_t)(cur_nonce - elm->cur_nonce);
+        elm->cur_nonce = cur_nonce;
+      }
+    return hashes;
+}
+
+/*
+ * CPU pool task of the CPU device with -K: worker t runs thread t of the
+ * native kernel over the table, leaving it and the result buffer as a GPU
+ * would, unless all its elements are parked. The parked elements of the other
+ * threads are lanes of the same vectors as the others, so they cost nothing
+ * more. Returns the number of hashes done by the elements not parked.
+ */
+uint64_t cpu_kernel_worker(void *arg, int t)
+{
+    gpu_state_t *gs = arg;
+    state_buf_t *buf = gs->buf + gs->run_buf;
+    elm_state_t *elm = buf->host[t].elm;
+    uint32_t cb[32], cur_nonce[ELM_PER_THREAD];
+    uint64_t hashes = 0;
+    bool parked = true;
+    for (int e = 0; e < ELM_PER_THREAD; e++)
+        parked &= cpu_elm_parked(gs, t, e);
+    if (parked)
+        return 0;
+    work_constants(cb, &gs->cur->work);
+    il_mem_t mem = {
+        .g = (uint32_t *)buf->host,
+        .g_elms = gs->nr_threads * sizeof (thread_state_t) / 16,
+        .cb = { sha256_k, cb },
+        .cb_elms = { 16, 8 },
+        .uav1 = (uint32_t *)buf->hostResults,
+        .uav1_size = compact_results ? sizeof (results_t) : 0,
+    };
+    for (int e = 0; e < ELM_PER_THREAD; e++)
+        cur_nonce[e] = elm[e].cur_nonce;
+    il_native_run(cpu_kernel, &mem, t, 1, 0, NULL);
+    for (int e = 0; e < ELM_PER_THREAD; e++)
+        if (!cpu_elm_parked(gs, t, e))
+            hashes += (uint32_t)(elm[e].cur_nonce - cur_nonce[e]);
+    return hashes;
+}
+
+/*
+ * Compiles the cbuf kernel of the result mode to native code for -K, and
+ * returns its single-thread hash rate in Mhash/sec, measured on the test
+ * work.
+ */
+double cpu_kernel_load(void)
+{
+    const int mode = kernel_mode;
+    const unsigned iters = 0x1000;
+    uint32_t *g = calloc(1, sizeof (thread_state_t));
+    thread_state_t *ts = (thread_state_t *)g;
+    results_t results = { .count = 0 };
+    struct timeval tv_start, tv_end;
+    sha256_work_t w;
+    il_kernel_t *k;
+    uint32_t cb[32];
+    const char *err;
+    char *src;
+    int line;
+    kernel_mode = KERNEL_CBUF;
+    generate_il(&src, NULL, threads_per_grp);
+    kernel_mode = mode;
+    if (!(k = il_parse(src, &err, &line)))
+        fprintf(stderr, "IL line %d: %s\n", line, err), exit(1);
+    free(src);
+    if (!(cpu_kernel = il_native_load(k, &err)))
+        fprintf(stderr, "Native kernel: %s\n", err), exit(1);
+    il_free(k);
+    if (!g)
+        perror("calloc"), exit(1);
+    // ranges away from the known answer, so that every element scans them
+    // all
+    sha256_work_init(&w, (uint32_t[32]){ [16] = sha256_test_data[0],
+            sha256_test_data[1], sha256_test_data[2] }, sha256_test_midstate);
+    work_constants(cb, &w);
+    for (int e = 0; e < ELM_PER_THREAD; e++)
+      {
+        ts->elm[e].cur_nonce = sha256_test_nonce + 1 + e * iters;
+        ts->elm[e].end_nonce = ts->elm[e].cur_nonce + iters;
+        ts->elm[e].iterations = iters;
+      }
+    il_mem_t mem = {
+        .g = g,
+        .g_elms = sizeof (*ts) / 16,
+        .cb = { sha256_k, cb },
+        .cb_elms = { 16, 8 },
+        .uav1 = (uint32_t *)&results,
+        .uav1_size = sizeof (results),
+    };
+    gettimeofday(&tv_start, NULL);
+    il_native_run(cpu_kernel, &mem, 0, 1, 0, NULL);
+    gettimeofday(&tv_end, NULL);
+    free(g);
+    double s = tv_end.tv_sec - tv_start.tv_sec +
+        (tv_end.tv_usec - tv_start.tv_usec) / 1e6;
+    return ELM_PER_THREAD * iters / fmax(s, 1e-6) / 1e6;
+}
+
+void threads_start(gpu_state_t *gs, int b)
+{
+    state_buf_t *buf = gs->buf + b;
+    buf->seeded = false;
+    gs->run_buf = gs->last_buf = b;
+    gettimeofday(&buf->tv_start, NULL);
+    if (gs->cpu)
+      {
+        cpu_pool_run(gs->pool, cpu_kernel ? cpu_kernel_worker :
+                cpu_scan_worker, gs);
+        gs->have_run = true;
+        return;
+      }
+    if (CAL_RESULT_OK != calCtxSetMem(gs->ctx, gs->globalName, buf->mem))
+        fatal("calCtxSetMem");
+    if (compact_results && CAL_RESULT_OK != calCtxSetMem(gs->ctx,
+                gs->resultsName, buf->resultsMem))
+        fatal("calCtxSetMem");
     if (CAL_RESULT_OK != calCtxRunProgramGrid(&gs->e, gs->ctx, &gs->pg))
         fatal("calCtxRunProgram");
     if (CAL_RESULT_OK != calCtxFlush(gs->ctx))
@@ -678,35 +1768,172 @@ void threads_start(gpu_state_t *gs)
     gs->have_run = true;
 }
 
-void do_run(gpu_state_t *gs_base, CALuint nr_devs)
+/*
+ * Unless the device is running, starts the state table that was not run last
+ * if it is seeded, and otherwise the other one if it is.
+ */
+void threads_start_next(gpu_state_t *gs)
 {
-    const int forever = 42;
-    CALuint devi;
-    int i = 0;
-    printf("Running on GPUs\n");
-    while (forever)
+    if (gs->run_buf >= 0)
+        return;
+    for (int i = 1; i <= NR_STATE_BUFS; i++)
       {
-        for (devi = 0; devi < nr_devs; devi++)
+        int b = (gs->last_buf + i) % NR_STATE_BUFS;
+        if (gs->buf[b].seeded)
+          {
+            threads_start(gs, b);
+            return;
+          }
+      }
+}
+
+/*
+ * Times the kernel with each number of threads per group of
+ * threads_per_grp_sweep on the device, and keeps the fastest. Each is run a
+ * few times, with table 0 seeded with disjoint ranges; what it hashes does not
+ * matter, so cb1 is left as is. The iterations of the device are scaled after
+ * each run to last about tune_run_ms, which keeps the sweep short and gives
+ * the device its first value.
+ */
+void sweep_threads_per_grp(gpu_state_t *gs)
+{
+    const int nr_runs = 2;
+    double best_rate = 0;
+    int best = threads_per_grp;
+    for (unsigned c = 0; c < sizeof (threads_per_grp_sweep) /
+            sizeof (*threads_per_grp_sweep); c++)
+      {
+        gs->threads_per_grp = threads_per_grp_sweep[c];
+        gs->nr_threads = gs->nr_simds * gs->threads_per_grp;
+        CALimage img = compile_kernel(NULL, gs->target, gs->threads_per_grp,
+                true);
+        alloc_device_res(gs);
+        load_module(gs, img);
+        double rate = 0;
+        for (int r = 0; r < nr_runs; r++)
           {
-            gpu_state_t *gs = gs_base + devi;
-	    if (!gs->used)
-		continue;
-            if (!threads_running(gs))
+            elm_state_t *elm = map_state(gs, 0);
+            for (int i = 0; i < gs->nr_threads * ELM_PER_THREAD; i++)
               {
-                threads_analyze_and_prepare(devi, gs);
-                threads_start(gs);
+                elm[i].status = s_searching;
+                elm[i].cur_nonce = i * gs->iterations;
+                elm[i].end_nonce = elm[i].cur_nonce + gs->iterations;
+                elm[i].iterations = gs->iterations;
               }
+            unmap_state(gs, 0, "calResUnmap 3");
+            threads_start(gs, 0);
+            threads_wait(gs);
+            double t = run_time(gs->buf);
+            // the elements that found a candidate stopped early
+            uint64_t scanned = 0;
+            elm = map_state(gs, 0);
+            for (int i = 0; i < gs->nr_threads * ELM_PER_THREAD; i++)
+                scanned += (uint32_t)(elm[i].cur_nonce - i * gs->iterations);
+            unmap_state(gs, 0, "calResUnmap 4");
+            if (t <= 0)
+                continue;
+            rate = fmax(rate, scanned / t / 1e6);
+            gs->iterations = fmin(fmax(gs->iterations * tune_run_ms / 1e3 / t,
+                        min_iterations), max_iterations);
           }
-        if (!(i % show_stats_every_x_ms))
-            show_global_stats(gs_base, nr_devs);
-        struct timespec req = { .tv_sec = 0, .tv_nsec = 1e6 };
+        unload_module(gs);
+        free_device_res(gs);
+        if (CAL_RESULT_OK != calImageFree(img))
+            fatal("calImageFree");
+        if (verbose)
+            printf("Device %u: %d threads per SIMD, %.0f Mhash/sec\n",
+                    gs->devi, gs->threads_per_grp, rate);
+        if (rate > best_rate)
+          {
+            best_rate = rate;
+            best = gs->threads_per_grp;
+          }
+      }
+    // for runs lasting as long with the threads of the best
+    gs->iterations = fmin(fmax((double)gs->iterations * gs->threads_per_grp /
+                best, min_iterations), max_iterations);
+    gs->threads_per_grp = best;
+    gs->nr_threads = gs->nr_simds * gs->threads_per_grp;
+    gs->have_run = false;
+    gs->last_buf = NR_STATE_BUFS - 1;
+    printf("Device %u: launching %i threads (%d per SIMD)\n",
+            gs->devi, gs->nr_threads, gs->threads_per_grp);
+}
+
+/*
+ * Feeds one device: waits for each run to complete, starts the next one,
+ * seeded beforehand, and only then analyzes the completed run, without
+ * waiting on the other devices.
+ */
+void *device_thread(void *arg)
+{
+    gpu_state_t *gs = arg;
+    const int forever = 42;
+    while (forever)
+      {
+        int done = gs->run_buf;
+        threads_wait(gs);
+        threads_start_next(gs);
+        threads_analyze_and_prepare(gs->devi, gs, done);
+        threads_start_next(gs);
+      }
+    return NULL;
+}
+
+void do_run(gpu_state_t *gs_base, CALuint nr_devs)
+{
+    const int forever = 42;
+    CALuint devi;
+    printf("Running on %s\n", cpu_mode ? "CPU" : "GPUs");
+    for (devi = 0; devi < nr_devs; devi++)
+      {
+        gpu_state_t *gs = gs_base + devi;
+        if (!gs->used)
+            continue;
+        if (pthread_create(&gs->thread, NULL, device_thread, gs))
+            perror("pthread_create"), exit(1);
+      }
+    while (forever)
+      {
+        show_global_stats(gs_base, nr_devs);
+        struct timespec req = {
+            .tv_sec = show_stats_every_x_ms / 1000,
+            .tv_nsec = show_stats_every_x_ms % 1000 * 1e6
+        };
         nanosleep(&req, NULL);
-        i++;
       }
 }
 
 void finish_run(gpu_state_t *gs)
 {
+    if (gs->have_run)
+      {
+        // before releasing the image of the current work item
+        unload_module(gs);
+        free_device_res(gs);
+      }
+    nonce_sched_free(&gs->sched);
+    for (int b = 0; b < NR_STATE_BUFS; b++)
+        free(gs->buf[b].ranges);
+    if (gs->cur)
+        work_item_release(gs->cur);
+    for (unsigned i = 0; i < gs->nr_ahead; i++)
+        work_item_release(gs->ahead[i]);
+    free(gs->ahead);
+    pthread_mutex_destroy(&gs->ahead_lock);
+    if (gs->cpu)
+      {
+        cpu_pool_destroy(gs->pool);
+        for (int b = 0; b < NR_STATE_BUFS; b++)
+          {
+            free(gs->buf[b].host);
+            free(gs->buf[b].hostResults);
+          }
+        return;
+      }
+    if (gs->img && CAL_RESULT_OK != calImageFree(gs->img))
+        fatal("calImageFree");
+    image_patch_free(&gs->patch);
     // close device
     if (CAL_RESULT_OK != calCtxDestroy(gs->ctx))
         fatal("calCtxDestroy");
@@ -719,7 +1946,7 @@ void handle(instr_t *i)
     switch (i->id)
       {
         case CREATE_NEXT_WORK_ITEM:
-            create_next_work_item(i->devi, i->gs);
+            create_next_work_item(i->devi, i->gs, i->lead_time);
             break;
         case VERIFY_POTENTIAL_FIND:
             verify_potential_find(i->devi, i->datawords, i->nonce);
@@ -758,13 +1985,15 @@ void prepare_and_run(CALuint nr_devs)
     CALuint devi;
     CALdeviceattribs attribs;
     pthread_t t;
-    gpu_state_t *gs_base = malloc(nr_devs * sizeof (*gs_base));
+    // the host CPU, if used, is an extra device after the CAL devices
+    gpu_state_t *gs_base = calloc(nr_devs + cpu_mode, sizeof (*gs_base));
     if (!gs_base)
-        perror("malloc"), exit(1);
+        perror("calloc"), exit(1);
     // get attributes of the target devices
     for (devi = 0; devi < nr_devs; devi++)
       {
         gpu_state_t *gs = gs_base + devi;
+        gs->devi = devi;
         attribs.struct_size = sizeof(CALdeviceattribs);
         if (CAL_RESULT_OK != calDeviceGetAttribs(&attribs, devi))
             fatal("calDeviceGetAttribs");
@@ -784,27 +2013,66 @@ void prepare_and_run(CALuint nr_devs)
 	    gs->used = false;
 	    continue;
 	  }
+        gs->remote = state_mem == MEM_UNCACHED ? attribs.uncachedRemoteRAM > 0 :
+            state_mem == MEM_CACHED && attribs.cachedRemoteRAM > 0;
+        if (state_mem != MEM_LOCAL && !gs->remote)
+            printf("no remote RAM, ");
+        gs->threads_per_grp = threads_per_grp;
         gs->nr_threads = gs->nr_simds * threads_per_grp;
-        printf("launching %i threads\n", gs->nr_threads);
+        gs->iterations = iterations;
+        if (tune_threads_per_grp)
+            printf("tuning threads per SIMD\n");
+        else
+            printf("launching %i threads\n", gs->nr_threads);
 	gs->used = true;
 	nr_devs_used++;
         gs->target = attribs.target;
       }
+    if (cpu_mode)
+      {
+        gpu_state_t *gs = gs_base + nr_devs;
+        gs->devi = nr_devs;
+        gs->cpu = true;
+        gs->pool = cpu_pool_create(cpu_threads, cpuset_str, cpu_smt, verbose);
+        gs->nr_threads = gs->pool->nr_workers;
+        gs->iterations = cpu_iterations;
+        printf("Device %u: host CPU, launching %i threads\n",
+                nr_devs, gs->nr_threads);
+        gs->used = true;
+        nr_devs_used++;
+        nr_devs++;
+      }
     printf("Found %u usable device%s\n", nr_devs_used,
 	    nr_devs_used != 1 ? "s" : "");
     if (!nr_devs_used)
 	exit(1);
     if (pipe(pipefd))
         perror("pipe"), exit(1);
+    // compilations of different GPUs run concurrently, one per CPU at most
+    if (nr_devs_used > cpu_mode)
+        compile_pool = compile_pool_create(nr_devs_used - cpu_mode, verbose);
     for (devi = 0; devi < nr_devs; devi++)
       {
 	if (!gs_base[devi].used)
 	    continue;
         prepare_run(devi, gs_base + devi);
       }
+    if (compile_pool)
+        compile_pool_wait(compile_pool);
+    for (unsigned n = 0; n < work_ahead; n++)
+        for (devi = 0; devi < nr_devs; devi++)
+          {
+            if (!gs_base[devi].used)
+                continue;
+            create_next_work_item(devi, gs_base + devi, 0);
+          }
+    if (compile_pool)
+        compile_pool_wait(compile_pool);
     if (pthread_create(&t, NULL, controller_thread, NULL))
         perror("pthread_create"), exit(1);
     do_run(gs_base, nr_devs);
+    if (compile_pool)
+        compile_pool_destroy(compile_pool);
     for (devi = 0; devi < nr_devs; devi++)
       {
 	if (!gs_base[devi].used)
@@ -818,16 +2086,309 @@ void cal_puts(const CALchar *msg)
     fputs(msg, stdout);
 }
 
-void disassemble(const char *src)
+void disassemble(void)
 {
-    CALobject obj;
-    if (CAL_RESULT_OK != calclCompile(&obj, CAL_LANGUAGE_IL, src,
-                disassemble_target))
-        fatal("calclCompile");
-    if (1)
-        patch_bfi_int_instructions(verbose, &obj, bytes_to_patch,
-                expected_patched_instr_min, expected_patched_instr_max);
-    calclDisassembleObject(&obj, cal_puts);
+    CALimage img = compile_kernel(NULL, disassemble_target, threads_per_grp,
+            true);
+    calclDisassembleImage(img, cal_puts);
+    if (CAL_RESULT_OK != calImageFree(img))
+        fatal("calImageFree");
+}
+
+/*
+ * A run of a kernel by the IL interpreter, or by its native translation if n
+ * is set, and what the reference double hash says it must leave.
+ */
+typedef struct
+{
+    il_kernel_t		*k;
+    il_native_t		*n;
+    il_mem_t		mem;
+    const sha256_work_t	*w;
+    int			nr_threads;
+    int			nr_workers;
+    uint32_t		(*h)[4];	// r8 of each thread, the H words
+    thread_state_t	*ref;
+    results_t		*ref_results;
+    uint32_t		(*ref_h)[4];
+    uint64_t		hashes;
+    double		kernel_s;	// wall time of the kernel runs only
+}		check_run_t;
+
+/*
+ * Does to thread t of the expected table what the kernel does (see
+ * status_tail and compact_tail in kernel-sha256.pl), hashing with sha256d_h.
+ * Returns the number of hashes done.
+ */
+uint64_t check_ref_thread(check_run_t *r, int t)
+{
+    elm_state_t *elm = r->ref[t].elm;
+    uint32_t *h = r->ref_h[t];
+    uint32_t i = 0;
+    memset(h, 0, 4 * sizeof (*h));
+    for (;;)
+      {
+        bool active[ELM_PER_THREAD], stop = false;
+        for (int e = 0; e < ELM_PER_THREAD; e++)
+            active[e] = !compact_results ||
+                elm[e].cur_nonce != elm[e].end_nonce;
+        if (!active[0] && !active[1] && !active[2] && !active[3])
+            break;
+        for (int e = 0; e < ELM_PER_THREAD; e++)
+          {
+            h[e] = sha256d_h(r->w, elm[e].cur_nonce);
+            if (compact_results && active[e] && !h[e])
+              {
+                uint32_t slot = __sync_fetch_and_add(&r->ref_results->count,
+                        1);
+                if (slot >= RESULT_SLOTS)
+                    slot = RESULT_SLOTS - 1;
+                r->ref_results->found[slot].nonce = elm[e].cur_nonce;
+                r->ref_results->found[slot].elm = t * ELM_PER_THREAD + e;
+              }
+            if (active[e])
+                elm[e].cur_nonce++;
+            stop |= !h[e] || elm[e].cur_nonce == elm[e].end_nonce;
+          }
+        // 0 iterations is 2^32 of them, like in the kernel
+        if (++i == elm[0].iterations || (!compact_results && stop))
+            break;
+      }
+    for (int e = 0; !compact_results && e < ELM_PER_THREAD; e++)
+        elm[e].status = !h[e] ? s_found :
+            elm[e].cur_nonce == elm[e].end_nonce ? s_finished : s_searching;
+    return (uint64_t)i * ELM_PER_THREAD;
+}
+
+/*
+ * CPU pool tasks of check_run: each worker runs the kernel over a slice of the
+ * threads, then computes what they must leave.
+ */
+uint64_t check_kernel_worker(void *arg, int worker)
+{
+    check_run_t *r = arg;
+    int first = r->nr_threads * worker / r->nr_workers;
+    int last = r->nr_threads * (worker + 1) / r->nr_workers;
+    if (r->n)
+        il_native_run(r->n, &r->mem, first, last - first, 8, r->h + first);
+    else
+        il_run(r->k, &r->mem, first, last - first, 8, r->h + first);
+    return 0;
+}
+
+uint64_t check_ref_worker(void *arg, int worker)
+{
+    check_run_t *r = arg;
+    int first = r->nr_threads * worker / r->nr_workers;
+    int last = r->nr_threads * (worker + 1) / r->nr_workers;
+    uint64_t hashes = 0;
+    for (int t = first; t < last; t++)
+        hashes += check_ref_thread(r, t);
+    __sync_fetch_and_add(&r->hashes, hashes);
+    return hashes;
+}
+
+int cmp_candidates(const void *a, const void *b)
+{
+    const candidate_t *x = a, *y = b;
+    if (x->elm != y->elm)
+        return x->elm < y->elm ? -1 : 1;
+    return x->nonce < y->nonce ? -1 : x->nonce > y->nonce;
+}
+
+/*
+ * Interprets a run of r->k over table with the CPU pool, and compares what it
+ * leaves (table, result buffer and H words) to the reference. Returns the
+ * number of mismatches.
+ */
+int check_run(cpu_pool_t *pool, check_run_t *r, void *table,
+        const char *name)
+{
+    const size_t size = r->nr_threads * sizeof (thread_state_t);
+    thread_state_t *g = table;
+    results_t results = { .count = 0 }, ref_results = { .count = 0 };
+    int errors = 0;
+    if (!(r->ref = malloc(size)))
+        perror("malloc"), exit(1);
+    memcpy(r->ref, g, size);
+    r->mem.g = table;
+    r->mem.g_elms = size / 16;
+    r->mem.uav1 = (uint32_t *)&results;
+    r->mem.uav1_size = sizeof (results);
+    r->ref_results = &ref_results;
+    r->nr_workers = pool->nr_workers;
+    struct timeval tv_start, tv_end;
+    gettimeofday(&tv_start, NULL);
+    cpu_pool_run(pool, check_kernel_worker, r);
+    cpu_pool_wait(pool);
+    gettimeofday(&tv_end, NULL);
+    r->kernel_s += tv_seconds(&tv_end) - tv_seconds(&tv_start);
+    cpu_pool_run(pool, check_ref_worker, r);
+    cpu_pool_wait(pool);
+    for (int t = 0; t < r->nr_threads && errors < 10; t++)
+        for (int e = 0; e < ELM_PER_THREAD; e++)
+          {
+            const elm_state_t *got = g[t].elm + e, *exp = r->ref[t].elm + e;
+            if (r->h[t][e] != r->ref_h[t][e])
+                fprintf(stderr, "Kernel %s: thread %d elm %d: H 0x%08x, "
+                        "expected 0x%08x\n", name, t, e, r->h[t][e],
+                        r->ref_h[t][e]), errors++;
+            if (memcmp(got, exp, sizeof (*got)))
+                fprintf(stderr, "Kernel %s: thread %d elm %d: status %u "
+                        "nonce 0x%08x, expected status %u nonce 0x%08x\n",
+                        name, t, e, got->status, got->cur_nonce, exp->status,
+                        exp->cur_nonce), errors++;
+          }
+    if (results.count != ref_results.count)
+        fprintf(stderr, "Kernel %s: %u candidates, expected %u\n", name,
+                results.count, ref_results.count), errors++;
+    else if (results.count <= RESULT_SLOTS)
+      {
+        // the order of the candidates depends on that of the threads
+        qsort(results.found, results.count, sizeof (candidate_t),
+                cmp_candidates);
+        qsort(ref_results.found, results.count, sizeof (candidate_t),
+                cmp_candidates);
+        if (memcmp(results.found, ref_results.found,
+                    results.count * sizeof (candidate_t)))
+            fprintf(stderr, "Kernel %s: wrong candidates\n", name), errors++;
+      }
+    free(r->ref);
+    return errors;
+}
+
+uint32_t random32(void)
+{
+    return (uint32_t)random() << 16 ^ random();
+}
+
+/*
+ * Loads the kernel of the current kernel mode for w into r, and its native
+ * translation if native is set.
+ */
+void check_load(check_run_t *r, const sha256_work_t *w, bool native)
+{
+    char *src;
+    const char *err;
+    int line;
+    il_native_free(r->n);
+    r->n = NULL;
+    il_free(r->k);
+    generate_il(&src, w, threads_per_grp);
+    if (!(r->k = il_parse(src, &err, &line)))
+        fprintf(stderr, "IL line %d: %s\n", line, err), exit(1);
+    free(src);
+    if (native && !(r->n = il_native_load(r->k, &err)))
+        fprintf(stderr, "Native kernel: %s\n", err), exit(1);
+}
+
+/*
+ * Runs the kernels of every kernel mode through the IL interpreter (-X), over
+ * at least nonces nonces each, and checks them against sha256d_h: first over
+ * random work, iterations and ranges, then around the known answer of the
+ * test work. The cbuf kernels are then checked the same way once compiled to
+ * native code (the literal ones would need a compilation per work). Exits
+ * with 1 on a mismatch.
+ */
+void check_kernels(uint64_t nonces)
+{
+    static const char *names[3][2] = {
+        { "literal", "literal compact" }, { "cbuf", "cbuf compact" },
+        { "native", "native compact" } };
+    cpu_pool_t *pool = cpu_pool_create(cpu_threads, cpuset_str, cpu_smt,
+            verbose);
+    const int nr_threads = 256 * pool->nr_workers;
+    const size_t size = nr_threads * sizeof (thread_state_t);
+    thread_state_t *g = malloc(size);
+    check_run_t r = { .nr_threads = nr_threads };
+    uint32_t cb[32];
+    int errors = 0;
+    r.h = malloc(nr_threads * sizeof (*r.h));
+    r.ref_h = malloc(nr_threads * sizeof (*r.ref_h));
+    if (!g || !r.h || !r.ref_h)
+        perror("malloc"), exit(1);
+    r.mem.cb[0] = sha256_k;
+    r.mem.cb_elms[0] = 16;
+    r.mem.cb[1] = cb;
+    r.mem.cb_elms[1] = 8;
+    srandom(1);
+    for (int mode = 0; mode < 3; mode++)
+        for (int compact = 0; compact < 2; compact++)
+          {
+            const char *name = names[mode][compact];
+            const bool cbuf = mode > 0, native = mode == 2;
+            sha256_work_t w;
+            uint32_t datawords[32], midstate[8];
+            kernel_mode = cbuf ? KERNEL_CBUF : KERNEL_LITERAL;
+            compact_results = compact;
+            r.hashes = 0;
+            r.kernel_s = 0;
+            r.w = &w;
+            if (cbuf)
+                check_load(&r, NULL, native);
+            // random work and ranges, a few iterations: every element stops
+            // on its end nonce or on the iterations
+            while (r.hashes < nonces && errors < 10)
+              {
+                for (int i = 0; i < 32; i++)
+                    datawords[i] = random32();
+                for (int i = 0; i < 8; i++)
+                    midstate[i] = random32();
+                sha256_work_init(&w, datawords, midstate);
+                work_constants(cb, &w);
+                if (!cbuf)
+                    check_load(&r, &w, false);
+                unsigned iters = 1 + random() % 4;
+                for (int t = 0; t < nr_threads; t++)
+                    for (int e = 0; e < ELM_PER_THREAD; e++)
+                      {
+                        elm_state_t *elm = g[t].elm + e;
+                        memset(elm, 0, sizeof (*elm));
+                        elm->cur_nonce = random32();
+                        elm->end_nonce = elm->cur_nonce + random() % 6;
+                        elm->iterations = iters;
+                      }
+                errors += check_run(pool, &r, g, name);
+              }
+            // ranges of 0 to 2 * iters nonces around the known answer
+            sha256_work_init(&w, (uint32_t[32]){ [16] = sha256_test_data[0],
+                    sha256_test_data[1], sha256_test_data[2] },
+                    sha256_test_midstate);
+            work_constants(cb, &w);
+            if (!cbuf)
+                check_load(&r, &w, false);
+            const unsigned iters = 64;
+            uint32_t nonce = sha256_test_nonce - nr_threads *
+                ELM_PER_THREAD * iters / 2;
+            for (int t = 0; t < nr_threads; t++)
+                for (int e = 0; e < ELM_PER_THREAD; e++)
+                  {
+                    elm_state_t *elm = g[t].elm + e;
+                    memset(elm, 0, sizeof (*elm));
+                    elm->cur_nonce = nonce;
+                    nonce += (t * ELM_PER_THREAD + e) * 7919 % (2 * iters);
+                    elm->end_nonce = nonce;
+                    elm->iterations = iters;
+                  }
+            if (!errors)
+                errors += check_run(pool, &r, g, name);
+            // the rate is that of the kernel runs alone: neither the loading
+            // (and compilation) of the kernel nor the reference is timed
+            printf("Kernel %s: %llu nonces checked, %.2f Mhash/sec: %s\n",
+                    name, (unsigned long long)r.hashes,
+                    r.hashes / r.kernel_s / 1e6,
+                    errors ? "FAILED" : "OK");
+            il_native_free(r.n);
+            r.n = NULL;
+            il_free(r.k);
+            r.k = NULL;
+            if (errors)
+                exit(1);
+          }
+    cpu_pool_destroy(pool);
+    free(r.ref_h);
+    free(r.h);
+    free(g);
 }
 
 void usage(const char *name)
@@ -836,15 +2397,43 @@ void usage(const char *name)
             "\n"
             "Arguments:\n"
             "  -a <user:pwd>   Bitcoin JSON-RPC user and password (default bitcoin:password)\n"
+            "  -C <n,n-m...>   Limit CPU mining to this set of CPUs (default all)\n"
+            "  -c              Mine on the host CPU instead of GPUs (no CAL device needed)\n"
+            "  -D <dir>        Cache compiled kernels in this directory, \"\" to disable\n"
+            "                  (default $XDG_CACHE_HOME/hdminer or ~/.cache/hdminer)\n"
             "  -d <target>     Disassemble kernel for this target device\n"
+            "  -e <file>       Analyze an ELF CAL object saved with -o (no CAL device needed)\n"
             "  -G <n,n...>     Limit execution to this set of GPU devices (default all)\n"
             "  -g <nr-gpus>    Limit execution to the first <nr-gpus> GPUs (default all)\n"
             "  -h              Display this help\n"
-            "  -i <iterations> Number of iterations of the main compute loop (default 4096)\n"
+            "  -i <iterations> Number of iterations of the main compute loop (default 4096),\n"
+            "                  initial value with -m\n"
+            "  -K              With -c, mine with the cbuf kernel compiled to native code\n"
+            "                  instead of the CPU SHA-256 engines ($CC, cc by default)\n"
+            "  -k <mode>       Kernel reads work from: literal (compiled per work item),\n"
+            "                  patch (literals patched into a compiled image), verify\n"
+            "                  (patch, checked against a recompile), cbuf (default)\n"
+            "  -M <memory>     Memory of the GPU state tables and result buffers: local\n"
+            "                  (default), or uncached or cached remote (host) memory,\n"
+            "                  read without mapping them after each run (falls back to\n"
+            "                  local memory without remote RAM)\n"
+            "  -m <ms>         Adjust iterations so that kernel runs last this long,\n"
+            "                  0 to disable (default 100)\n"
+            "  -n <nonces>     Nonces handed at a time to a kernel element (default 4 * iterations)\n"
+            "  -o <file>       Save the ELF CAL object of compiled kernels (before patching),\n"
+            "                  compiling them even if they are in the image cache\n"
             "  -p <port>       Bitcoin JSON-RPC server TCP port (default 8332)\n"
+            "  -r              Read back only the candidates found by a run, not the\n"
+            "                  state of every kernel element\n"
+            "  -S              Run at most 1 CPU thread per core (skip SMT siblings)\n"
             "  -s <server>     Bitcoin JSON-RPC server (default localhost)\n"
-            "  -t <threads>    Number of threads per SIMD (default 320)\n"
+            "  -T <threads>    Number of CPU mining threads (default 1 per CPU)\n"
+            "  -t <threads>    Number of threads per SIMD (default: the fastest of 64-384\n"
+            "                  with -m, 320 otherwise)\n"
             "  -v              Verbose mode\n"
+            "  -w <items>      Work items prepared ahead per device (default 2)\n"
+            "  -X <nonces>     Check the kernels with the IL interpreter against the host\n"
+            "                  SHA-256d over this many nonces each (no CAL device needed)\n"
             , name);
 }
 
@@ -855,14 +2444,29 @@ int main(int argc, char** argv)
     //assert(sizeof (thread_state_t) == 192);
     const char *gpuset_str = NULL;
     int opt;
-    while ((opt = getopt(argc, argv, "a:d:G:g:hi:p:s:t:v")) != -1) {
+    while ((opt = getopt(argc, argv, "a:C:cD:d:e:G:g:hi:Kk:M:m:n:o:p:rSs:T:t:vw:X:")) != -1) {
         switch (opt) {
             case 'a':
                 auth = optarg;
                 break;
+            case 'C':
+                cpuset_str = optarg;
+                break;
+            case 'c':
+                cpu_mode = true;
+                break;
+            case 'K':
+                cpu_use_kernel = true;
+                break;
+            case 'D':
+                cache_dir = optarg;
+                break;
             case 'd':
                 disassemble_target = strtoul(optarg, NULL, 0);
                 break;
+            case 'e':
+                analyze_object_path = optarg;
+                break;
             case 'G':
                 gpuset_str = optarg;
                 break;
@@ -875,18 +2479,77 @@ int main(int argc, char** argv)
             case 'i':
                 iterations = strtoul(optarg, NULL, 0);
                 break;
+            case 'k':
+                if (!strcmp(optarg, "literal"))
+                    kernel_mode = KERNEL_LITERAL;
+                else if (!strcmp(optarg, "patch"))
+                    kernel_mode = KERNEL_PATCH;
+                else if (!strcmp(optarg, "verify"))
+                  {
+                    kernel_mode = KERNEL_PATCH;
+                    verify_patch = true;
+                  }
+                else if (!strcmp(optarg, "cbuf"))
+                    kernel_mode = KERNEL_CBUF;
+                else
+                    fprintf(stderr, "Invalid kernel mode: %s\n", optarg),
+                        exit(1);
+                break;
+            case 'M':
+                if (!strcmp(optarg, "local"))
+                    state_mem = MEM_LOCAL;
+                else if (!strcmp(optarg, "uncached"))
+                    state_mem = MEM_UNCACHED;
+                else if (!strcmp(optarg, "cached"))
+                    state_mem = MEM_CACHED;
+                else
+                    fprintf(stderr, "Invalid memory: %s\n", optarg), exit(1);
+                break;
+            case 'm':
+                tune_run_ms = strtoul(optarg, NULL, 0);
+                break;
+            case 'n':
+                nonce_chunk = strtoul(optarg, NULL, 0);
+                break;
+            case 'o':
+#ifdef CALSHIM
+                // the objects of the software runtime hold IL, not ELF
+                fprintf(stderr, "-o needs the CAL compiler of the SDK\n"),
+                    exit(1);
+#endif
+                save_object_path = optarg;
+                break;
             case 'p':
                 port = strtoul(optarg, NULL, 0);
                 break;
+            case 'r':
+                compact_results = true;
+                break;
+            case 'S':
+                cpu_smt = false;
+                break;
             case 's':
                 server = optarg;
                 break;
+            case 'T':
+                cpu_threads = strtoul(optarg, NULL, 0);
+                break;
             case 't':
                 threads_per_grp = strtoul(optarg, NULL, 0);
+                tune_threads_per_grp = false;
                 break;
             case 'v':
                 verbose++;
                 break;
+            case 'w':
+                work_ahead = strtoul(optarg, NULL, 0);
+                if (!work_ahead)
+                    fprintf(stderr, "At least 1 work item must be prepared "
+                            "ahead\n"), exit(1);
+                break;
+            case 'X':
+                check_nonces = strtoull(optarg, NULL, 0);
+                break;
             default:
                 usage(argv[0]);
                 exit(1);
@@ -906,20 +2569,55 @@ int main(int argc, char** argv)
 	fprintf(stderr, "Cannot specify GPU set (-G) and maximum number of GPUs (-g) concurrently\n");
 	exit(1);
       }
+    if (analyze_object_path)
+      {
+        analyze_cal_object(verbose, analyze_object_path);
+        return 0;
+      }
+    if (check_nonces)
+      {
+        check_kernels(check_nonces);
+        return 0;
+      }
+    if (!tune_run_ms)
+        tune_threads_per_grp = false;
     init_gpuset(gpuset_str);
     if (-1 == asprintf(&rpc_url, "http://%s:%d/", server, port))
 	perror("asprintf"), exit(1);
+    if (cpu_mode)
+      {
+        double mhashpsec;
+        if (cpu_use_kernel)
+          {
+            mhashpsec = cpu_kernel_load();
+            printf("CPU engine native kernel (%.1f Mhash/sec per thread)\n",
+                    mhashpsec);
+          }
+        else
+          {
+            const cpu_engine_t *e = cpu_engine_select(verbose);
+            cpu_scan = e->scan;
+            mhashpsec = e->mhashpsec;
+            printf("CPU engine %s (%.1f Mhash/sec per thread)\n",
+                    e->name, mhashpsec);
+          }
+        cpu_iterations = mhashpsec * 1e3 * cpu_run_ms / ELM_PER_THREAD;
+        if (cpu_iterations < iterations)
+            cpu_iterations = iterations;
+        prepare_and_run(0);
+        il_native_free(cpu_kernel);
+        free(rpc_url);
+        return 0;
+      }
     printf("Initializing CAL... ");
     fflush(stdout);
     if (CAL_RESULT_OK != calInit())
         fatal("calInit");
     show_ver();
+    image_cache_init(cache_dir, verbose);
     if (disassemble_target != -1)
       {
-        char *src;
-        generate_il(&src, NULL, NULL);
-        disassemble(src);
-        free(src);
+        disassemble();
         exit(0);
       }
     if (verbose)
@@ -927,8 +2625,11 @@ int main(int argc, char** argv)
     CALuint nr_devs;
     if (CAL_RESULT_OK != calDeviceGetCount(&nr_devs))
         fatal("calDeviceGetCount");
-    printf("Found %u device%s, launching %u threads per SIMD\n",
-            nr_devs, nr_devs != 1 ? "s" : "", threads_per_grp);
+    if (tune_threads_per_grp)
+        printf("Found %u device%s\n", nr_devs, nr_devs != 1 ? "s" : "");
+    else
+        printf("Found %u device%s, launching %u threads per SIMD\n",
+                nr_devs, nr_devs != 1 ? "s" : "", threads_per_grp);
     if (max_gpus && nr_devs > max_gpus)
       {
         nr_devs = max_gpus;
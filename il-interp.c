@@ -0,0 +1,1158 @@
+#define _GNU_SOURCE
+#include <ctype.h>
+#include <dlfcn.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "il-interp.h"
+
+// threads run together, their registers are vectors of this many values
+#define IL_BATCH	16
+#define IL_NR_LITERALS	16
+
+typedef uint32_t	il_vec_t __attribute__((vector_size(4 * IL_BATCH)));
+
+enum
+{
+    OP_MOV, OP_IADD, OP_ISUB, OP_IXOR, OP_IOR, OP_IAND, OP_INOT, OP_IEQ,
+    OP_INE, OP_ISHL, OP_USHR, OP_UMUL, OP_UMIN, OP_UMAD, OP_BITALIGN, OP_BFI,
+    OP_GLOAD, OP_GSTORE, OP_UAV_ADD, OP_UAV_STORE,
+    OP_WHILELOOP, OP_ENDLOOP, OP_BREAK_NZ, OP_BREAK_Z, OP_IF_NZ, OP_IF_Z,
+    OP_ELSE, OP_ENDIF, OP_END,
+};
+
+static const struct
+{
+    const char	*name;
+    int		op;
+    int		nr_ops;		// operands, destination included
+}		il_ops[] = {
+    { "mov",			OP_MOV,		2 },
+    { "iadd",			OP_IADD,	3 },
+    { "isub",			OP_ISUB,	3 },
+    { "ixor",			OP_IXOR,	3 },
+    { "ior",			OP_IOR,		3 },
+    { "iand",			OP_IAND,	3 },
+    { "inot",			OP_INOT,	2 },
+    { "ieq",			OP_IEQ,		3 },
+    { "ine",			OP_INE,		3 },
+    { "ishl",			OP_ISHL,	3 },
+    { "ushr",			OP_USHR,	3 },
+    { "umul",			OP_UMUL,	3 },
+    { "umin",			OP_UMIN,	3 },
+    { "umad",			OP_UMAD,	4 },
+    { "bitalign",		OP_BITALIGN,	4 },
+    // patched to BFI_INT at runtime, see patch_bfi_int_instructions
+    { "ibit_extract",		OP_BFI,		4 },
+    { "uav_read_add_id(1)",	OP_UAV_ADD,	3 },
+    { "uav_raw_store_id(1)",	OP_UAV_STORE,	3 },
+    { "whileloop",		OP_WHILELOOP,	0 },
+    { "endloop",		OP_ENDLOOP,	0 },
+    { "break_logicalnz",	OP_BREAK_NZ,	1 },
+    { "break_logicalz",		OP_BREAK_Z,	1 },
+    { "if_logicalnz",		OP_IF_NZ,	1 },
+    { "if_logicalz",		OP_IF_Z,	1 },
+    { "else",			OP_ELSE,	0 },
+    { "endif",			OP_ENDIF,	0 },
+    { "endmain",		OP_END,		0 },
+};
+
+/*
+ * A decoded instruction. Operands are slots of the value file of a batch
+ * (one vector per component of a register, literal, constant or input).
+ */
+typedef struct
+{
+    uint8_t	op;
+    uint8_t	mask;		// components written
+    uint8_t	swz[3];		// of each source, 2 bits per component
+    bool	hazard;		// a component written is read by a later one
+    uint16_t	dst;		// slot of component x
+    uint16_t	src[3];		// likewise
+    int32_t	off;		// g[] element offset, or jump target
+    int32_t	skip;		// where to go on when no thread is active
+}		il_insn_t;
+
+/*
+ * Value file: literals, cb0, cb1, vAbsTidFlat, then r0, r1...
+ */
+struct il_kernel
+{
+    unsigned	threads_per_grp;
+    uint32_t	lit[IL_NR_LITERALS][4];
+    bool	has_lit[IL_NR_LITERALS];
+    unsigned	cb_elms[2];	// declared
+    unsigned	cb_base[2];	// slots
+    unsigned	tid_base;
+    unsigned	reg_base;
+    unsigned	nr_slots;
+    int		max_depth;	// of nested loops and ifs
+    il_insn_t	*insns;
+    int		nr_insns;
+};
+
+/*
+ * Control flow structures open while parsing, and the instructions waiting
+ * for the next else/endif/endloop of one of them as their skip target.
+ */
+typedef struct
+{
+    int		open[64];
+    int		depth;
+    int		*waiting;	// pairs of instruction, depth
+    int		nr_waiting;
+}		il_flow_t;
+
+#define IDENTITY_SWZ	0xe4 // .xyzw
+
+static char *skip_spaces(char *s)
+{
+    while (isspace((unsigned char)*s))
+        s++;
+    return s;
+}
+
+/*
+ * Parses ".xy" like swizzles (the last component is replicated) into *swz.
+ */
+static bool parse_swizzle(const char *s, uint8_t *swz)
+{
+    static const char comps[] = "xyzw";
+    int n = 0, c = 0;
+    *swz = 0;
+    for (; s[n]; n++)
+      {
+        const char *p = strchr(comps, s[n]);
+        if (n >= 4 || !p)
+            return false;
+        c = p - comps;
+        *swz |= c << (2 * n);
+      }
+    if (!n)
+        return false;
+    for (; n < 4; n++)
+        *swz |= c << (2 * n);
+    return true;
+}
+
+/*
+ * Parses ".xy__" or ".xy" like write masks into *mask.
+ */
+static bool parse_mask(const char *s, uint8_t *mask)
+{
+    static const char comps[] = "xyzw";
+    *mask = 0;
+    for (int n = 0; s[n]; n++)
+      {
+        const char *p = strchr(comps, s[n]);
+        if (s[n] == '_')
+            continue;
+        if (n >= 4 || !p)
+            return false;
+        *mask |= 1 << (p - comps);
+      }
+    return *mask;
+}
+
+/*
+ * Parses a register, literal, constant or input operand up to its swizzle (or
+ * mask), returning its first slot and pointing *end to what follows.
+ */
+static bool parse_name(il_kernel_t *k, char *s, unsigned *slot, char **end,
+        const char **err)
+{
+    unsigned long n, i;
+    if (!strncmp(s, "vAbsTidFlat", 11))
+      {
+        *slot = k->tid_base;
+        *end = s + 11;
+        return true;
+      }
+    if (s[0] == 'r' && isdigit((unsigned char)s[1]))
+      {
+        n = strtoul(s + 1, end, 10);
+        if (k->reg_base + 4 * (n + 1) > 0xffff)
+            return *err = "too many registers", false;
+        *slot = k->reg_base + 4 * n;
+        if (*slot + 4 > k->nr_slots)
+            k->nr_slots = *slot + 4;
+        return true;
+      }
+    if (s[0] == 'l' && isdigit((unsigned char)s[1]))
+      {
+        n = strtoul(s + 1, end, 10);
+        if (n >= IL_NR_LITERALS || !k->has_lit[n])
+            return *err = "undeclared literal", false;
+        *slot = 4 * n;
+        return true;
+      }
+    if (!strncmp(s, "cb", 2) && isdigit((unsigned char)s[2]))
+      {
+        n = strtoul(s + 2, end, 10);
+        if (**end != '[')
+            return *err = "expected cb<n>[<index>]", false;
+        i = strtoul(*end + 1, end, 10);
+        if (**end != ']')
+            return *err = "expected cb<n>[<index>]", false;
+        (*end)++;
+        if (n > 1 || i >= k->cb_elms[n])
+            return *err = "undeclared constant buffer element", false;
+        *slot = k->cb_base[n] + 4 * i;
+        return true;
+      }
+    return *err = "unsupported operand", false;
+}
+
+static bool parse_src(il_kernel_t *k, char *s, uint16_t *slot, uint8_t *swz,
+        const char **err)
+{
+    unsigned base;
+    char *end;
+    if (!parse_name(k, s, &base, &end, err))
+        return false;
+    *slot = base;
+    *swz = IDENTITY_SWZ;
+    if (*end == '.')
+        return parse_swizzle(end + 1, swz) || (*err = "bad swizzle", false);
+    return !*end || (*err = "unexpected characters after operand", false);
+}
+
+static bool parse_dst(il_kernel_t *k, char *s, uint16_t *slot, uint8_t *mask,
+        const char **err)
+{
+    unsigned base;
+    char *end;
+    if (s[0] != 'r')
+        return *err = "destination must be a register", false;
+    if (!parse_name(k, s, &base, &end, err))
+        return false;
+    *slot = base;
+    *mask = 0xf;
+    if (*end == '.')
+        return parse_mask(end + 1, mask) || (*err = "bad write mask", false);
+    return !*end || (*err = "unexpected characters after operand", false);
+}
+
+/*
+ * Parses g[r<n>.<c>+<offset>] followed by a swizzle or mask (suffix), the
+ * index register being returned like a source replicating component c.
+ */
+static bool parse_g(il_kernel_t *k, char *s, il_insn_t *i, char **suffix,
+        const char **err)
+{
+    char *end = strpbrk(s, "+-]");
+    if (!end)
+        return *err = "expected g[<register>+<offset>]", false;
+    char sep = *end;
+    *end = '\0';
+    if (!parse_src(k, s + 2, &i->src[1], &i->swz[1], err))
+        return false;
+    if (i->swz[1] != 0x00 && i->swz[1] != 0x55 && i->swz[1] != 0xaa &&
+            i->swz[1] != 0xff)
+        return *err = "g[] index must be a single component", false;
+    i->off = 0;
+    if (sep != ']')
+      {
+        i->off = strtol(end + 1, &end, 0);
+        if (sep == '-')
+            i->off = -i->off;
+        if (*end != ']')
+            return *err = "expected g[<register>+<offset>]", false;
+      }
+    *suffix = end + 1;
+    return true;
+}
+
+static bool parse_decl(il_kernel_t *k, char *op, char *args, const char **err)
+{
+    char *end;
+    if (!strcmp(op, "dcl_num_thread_per_group"))
+      {
+        k->threads_per_grp = strtoul(args, &end, 0);
+        return !*skip_spaces(end) || (*err = "bad thread count", false);
+      }
+    if (!strcmp(op, "dcl_raw_uav_id(1)"))
+        return true;
+    if (!strcmp(op, "dcl_cb"))
+      {
+        unsigned long n, size;
+        if (strncmp(args, "cb", 2))
+            return *err = "expected cb<n>[<size>]", false;
+        n = strtoul(args + 2, &end, 10);
+        if (*end != '[')
+            return *err = "expected cb<n>[<size>]", false;
+        size = strtoul(end + 1, &end, 10);
+        if (*end != ']' || n > 1 || size > 4096)
+            return *err = "only cb0[<size>] and cb1[<size>] are supported",
+                   false;
+        k->cb_elms[n] = size;
+        return true;
+      }
+    if (!strcmp(op, "dcl_literal"))
+      {
+        unsigned long n;
+        if (args[0] != 'l')
+            return *err = "expected l<n>", false;
+        n = strtoul(args + 1, &end, 10);
+        if (n >= IL_NR_LITERALS)
+            return *err = "literal out of range", false;
+        for (int c = 0; c < 4; c++)
+          {
+            end = skip_spaces(end);
+            if (*end != ',')
+                return *err = "expected 4 literal values", false;
+            k->lit[n][c] = strtoll(end + 1, &end, 0);
+          }
+        k->has_lit[n] = true;
+        return !*skip_spaces(end) || (*err = "expected 4 literal values",
+                false);
+      }
+    return *err = "unsupported declaration", false;
+}
+
+/*
+ * Sets the hazard flag of i if computing its components in order would
+ * overwrite one that a later component reads.
+ */
+static void check_hazard(il_insn_t *i, int nr_src)
+{
+    for (int c = 0; c < 4; c++)
+      {
+        if (!(i->mask & (1 << c)))
+            continue;
+        for (int later = c + 1; later < 4; later++)
+          {
+            if (!(i->mask & (1 << later)))
+                continue;
+            for (int s = 0; s < nr_src; s++)
+                if (i->src[s] == i->dst &&
+                        ((i->swz[s] >> (2 * later)) & 3) == c)
+                    i->hazard = true;
+          }
+      }
+}
+
+/*
+ * Sets the skip target of the instructions waiting for the next boundary of
+ * the structures open at depth (0 is the top level, ended by the program).
+ */
+static void resolve_waiting(il_kernel_t *k, il_flow_t *f, int depth, int to)
+{
+    int n = 0;
+    for (int w = 0; w < f->nr_waiting; w++)
+      {
+        if (f->waiting[2 * w + 1] == depth)
+            k->insns[f->waiting[2 * w]].skip = to;
+        else
+          {
+            f->waiting[2 * n] = f->waiting[2 * w];
+            f->waiting[2 * n + 1] = f->waiting[2 * w + 1];
+            n++;
+          }
+      }
+    f->nr_waiting = n;
+}
+
+static bool parse_flow(il_kernel_t *k, il_flow_t *f, int pc, const char **err)
+{
+    il_insn_t *i = k->insns + pc;
+    int open = f->depth ? f->open[f->depth - 1] : -1;
+    int open_op = open >= 0 ? k->insns[open].op : -1;
+    bool in_if = open_op == OP_IF_NZ || open_op == OP_IF_Z ||
+        open_op == OP_ELSE;
+    switch (i->op)
+      {
+        case OP_WHILELOOP:
+        case OP_IF_NZ:
+        case OP_IF_Z:
+            if (f->depth == sizeof (f->open) / sizeof (*f->open))
+                return *err = "control flow nested too deep", false;
+            f->open[f->depth++] = pc;
+            if (f->depth > k->max_depth)
+                k->max_depth = f->depth;
+            return true;
+        case OP_ELSE:
+            if (!in_if || open_op == OP_ELSE)
+                return *err = "else without if", false;
+            k->insns[open].off = pc;
+            resolve_waiting(k, f, f->depth, pc);
+            f->open[f->depth - 1] = pc;
+            return true;
+        case OP_ENDIF:
+        case OP_ENDLOOP:
+            if (i->op == OP_ENDIF ? !in_if : open_op != OP_WHILELOOP)
+                return *err = "unbalanced endif or endloop", false;
+            k->insns[open].off = pc;
+            if (i->op == OP_ENDLOOP)
+                i->off = open + 1;
+            resolve_waiting(k, f, f->depth, pc);
+            f->depth--;
+            break;
+        case OP_BREAK_NZ:
+        case OP_BREAK_Z:
+          {
+            int d = f->depth - 1;
+            while (d >= 0 && k->insns[f->open[d]].op != OP_WHILELOOP)
+                d--;
+            if (d < 0)
+                return *err = "break outside of a loop", false;
+            // ifs left by the break
+            i->off = f->depth - 1 - d;
+            break;
+          }
+        default:
+            return true;
+      }
+    // wait for the next boundary of the innermost structure left open
+    int *w = realloc(f->waiting, 2 * (f->nr_waiting + 1) * sizeof (*w));
+    if (!w)
+        return *err = "out of memory", false;
+    f->waiting = w;
+    w[2 * f->nr_waiting] = pc;
+    w[2 * f->nr_waiting + 1] = f->depth;
+    f->nr_waiting++;
+    return true;
+}
+
+/*
+ * Decodes the instruction op with its operands ops[] at k->insns[pc].
+ */
+static bool parse_insn(il_kernel_t *k, il_flow_t *f, int pc, char *op,
+        char **ops, int nr_ops, const char **err)
+{
+    il_insn_t *i = k->insns + pc;
+    unsigned o;
+    memset(i, 0, sizeof (*i));
+    for (o = 0; o < sizeof (il_ops) / sizeof (*il_ops); o++)
+        if (!strcmp(op, il_ops[o].name))
+            break;
+    if (o == sizeof (il_ops) / sizeof (*il_ops))
+        return *err = "unsupported instruction", false;
+    if (nr_ops != il_ops[o].nr_ops)
+        return *err = "wrong number of operands", false;
+    i->op = il_ops[o].op;
+    i->skip = -1;
+    if (i->op == OP_MOV && !strncmp(ops[0], "g[", 2))
+      {
+        char *suffix;
+        i->op = OP_GSTORE;
+        if (!parse_g(k, ops[0], i, &suffix, err))
+            return false;
+        i->mask = 0xf;
+        if (*suffix == '.' && !parse_mask(suffix + 1, &i->mask))
+            return *err = "bad write mask", false;
+        if (*suffix && *suffix != '.')
+            return *err = "unexpected characters after operand", false;
+        return parse_src(k, ops[1], &i->src[0], &i->swz[0], err);
+      }
+    if (i->op == OP_MOV && !strncmp(ops[1], "g[", 2))
+      {
+        char *suffix;
+        i->op = OP_GLOAD;
+        if (!parse_g(k, ops[1], i, &suffix, err))
+            return false;
+        i->swz[0] = IDENTITY_SWZ;
+        if (*suffix == '.' && !parse_swizzle(suffix + 1, &i->swz[0]))
+            return *err = "bad swizzle", false;
+        if (*suffix && *suffix != '.')
+            return *err = "unexpected characters after operand", false;
+        return parse_dst(k, ops[0], &i->dst, &i->mask, err);
+      }
+    if (i->op == OP_UAV_STORE)
+      {
+        i->mask = 0xf;
+        if (strncmp(ops[0], "mem", 3) || (ops[0][3] && (ops[0][3] != '.' ||
+                        !parse_mask(ops[0] + 4, &i->mask))))
+            return *err = "expected mem.<mask>", false;
+        return parse_src(k, ops[1], &i->src[0], &i->swz[0], err) &&
+            parse_src(k, ops[2], &i->src[1], &i->swz[1], err);
+      }
+    if (i->op >= OP_WHILELOOP)
+      {
+        if (nr_ops && !parse_src(k, ops[0], &i->src[0], &i->swz[0], err))
+            return false;
+        return parse_flow(k, f, pc, err);
+      }
+    if (!parse_dst(k, ops[0], &i->dst, &i->mask, err))
+        return false;
+    for (int s = 1; s < nr_ops; s++)
+        if (!parse_src(k, ops[s], &i->src[s - 1], &i->swz[s - 1], err))
+            return false;
+    check_hazard(i, nr_ops - 1);
+    return true;
+}
+
+/*
+ * Parses the IL source of a kernel. Returns NULL on error, with the reason in
+ * *err and the line in *line.
+ */
+il_kernel_t *il_parse(const char *src, const char **err, int *line)
+{
+    il_kernel_t *k = calloc(1, sizeof (*k));
+    il_flow_t flow = { .depth = 0 };
+    char *copy = strdup(src);
+    char *next = copy;
+    int max_insns = 0;
+    bool code = false;
+    *line = 0;
+    *err = "out of memory";
+    if (!k || !copy)
+        goto fail;
+    while (next)
+      {
+        char *s = next, *ops[4];
+        int nr_ops = 0;
+        next = strchr(s, '\n');
+        if (next)
+            *next++ = '\0';
+        (*line)++;
+        // drop the comment and surrounding spaces
+        if (strchr(s, ';'))
+            *strchr(s, ';') = '\0';
+        s = skip_spaces(s);
+        for (char *e = s + strlen(s); e > s && isspace((unsigned char)e[-1]);)
+            *--e = '\0';
+        if (!*s || !strcmp(s, "il_cs"))
+            continue;
+        if (!strcmp(s, "end"))
+            break;
+        char *op = s;
+        s += strcspn(s, " \t");
+        if (*s)
+            *s++ = '\0';
+        s = skip_spaces(s);
+        if (!strncmp(op, "dcl_", 4))
+          {
+            if (code)
+              {
+                *err = "declaration after the first instruction";
+                goto fail;
+              }
+            if (!parse_decl(k, op, s, err))
+                goto fail;
+            continue;
+          }
+        if (!code)
+          {
+            // the slots of everything declared are known by now
+            k->cb_base[0] = 4 * IL_NR_LITERALS;
+            k->cb_base[1] = k->cb_base[0] + 4 * k->cb_elms[0];
+            k->tid_base = k->cb_base[1] + 4 * k->cb_elms[1];
+            k->reg_base = k->tid_base + 4;
+            k->nr_slots = k->reg_base;
+            code = true;
+          }
+        while (*s)
+          {
+            if (nr_ops == 4)
+              {
+                *err = "too many operands";
+                goto fail;
+              }
+            ops[nr_ops++] = s;
+            s += strcspn(s, ",");
+            if (*s)
+                *s++ = '\0';
+            for (char *e = ops[nr_ops - 1] + strlen(ops[nr_ops - 1]);
+                    e > ops[nr_ops - 1] && isspace((unsigned char)e[-1]);)
+                *--e = '\0';
+            s = skip_spaces(s);
+          }
+        if (k->nr_insns == max_insns)
+          {
+            max_insns = max_insns ? 2 * max_insns : 1024;
+            il_insn_t *insns = realloc(k->insns,
+                    max_insns * sizeof (*insns));
+            if (!insns)
+                goto fail;
+            k->insns = insns;
+          }
+        if (!parse_insn(k, &flow, k->nr_insns, op, ops, nr_ops, err))
+            goto fail;
+        if (k->insns[k->nr_insns++].op == OP_END)
+          {
+            if (flow.depth)
+              {
+                *err = "endmain inside a loop or if";
+                goto fail;
+              }
+            resolve_waiting(k, &flow, 0, k->nr_insns - 1);
+          }
+      }
+    if (!k->nr_insns || k->insns[k->nr_insns - 1].op != OP_END)
+      {
+        *err = "no endmain";
+        goto fail;
+      }
+    free(flow.waiting);
+    free(copy);
+    return k;
+fail:
+    free(flow.waiting);
+    free(copy);
+    il_free(k);
+    return NULL;
+}
+
+unsigned il_threads_per_grp(const il_kernel_t *k)
+{
+    return k->threads_per_grp;
+}
+
+void il_free(il_kernel_t *k)
+{
+    if (!k)
+        return;
+    free(k->insns);
+    free(k);
+}
+
+// slot of component c of source s
+#define SRC(s, c)	(i->src[s] + ((i->swz[s] >> (2 * (c))) & 3))
+
+/*
+ * Applies expr to the active threads, for each component c written, with a,
+ * b and s the sources read by the component.
+ */
+#define ALU(expr) \
+    for (int c = 0; c < 4; c++) \
+      { \
+        if (!(i->mask & (1 << c))) \
+            continue; \
+        il_vec_t a = v[SRC(0, c)], b = v[SRC(1, c)], s = v[SRC(2, c)]; \
+        il_vec_t r = (expr); \
+        (void)b, (void)s; \
+        if (!full) \
+            r = (r & exec) | (v[i->dst + c] & ~exec); \
+        if (i->hazard) \
+            tmp[c] = r; \
+        else \
+            v[i->dst + c] = r; \
+      } \
+    if (i->hazard) \
+        for (int c = 0; c < 4; c++) \
+            if (i->mask & (1 << c)) \
+                v[i->dst + c] = tmp[c]; \
+    break
+
+static bool any(const il_vec_t *m)
+{
+    uint32_t r = 0;
+    for (int t = 0; t < IL_BATCH; t++)
+        r |= (*m)[t];
+    return r;
+}
+
+static bool all(const il_vec_t *m)
+{
+    uint32_t r = ~0U;
+    for (int t = 0; t < IL_BATCH; t++)
+        r &= (*m)[t];
+    return r == ~0U;
+}
+
+// threads active when entering loop or if level d (1 is the outermost), and
+// threads that took the if
+#define SAVED(d)	stack[2 * (d) - 2]
+#define TAKEN(d)	stack[2 * (d) - 1]
+
+/*
+ * Runs the threads of a batch, those not in *active being inactive from the
+ * start.
+ */
+static void run_batch(const il_kernel_t *k, const il_mem_t *m, il_vec_t *v,
+        il_vec_t *stack, const il_vec_t *active)
+{
+    il_vec_t tmp[4], hit, exec = *active;
+    bool full = all(&exec);
+    int depth = 0;
+    for (int pc = 0; pc < k->nr_insns;)
+      {
+        const il_insn_t *i = k->insns + pc++;
+        switch (i->op)
+          {
+            case OP_MOV:	ALU(a);
+            case OP_IADD:	ALU(a + b);
+            case OP_ISUB:	ALU(a - b);
+            case OP_IXOR:	ALU(a ^ b);
+            case OP_IOR:	ALU(a | b);
+            case OP_IAND:	ALU(a & b);
+            case OP_INOT:	ALU(~a);
+            case OP_IEQ:	ALU((il_vec_t)(a == b));
+            case OP_INE:	ALU((il_vec_t)(a != b));
+            case OP_ISHL:	ALU(a << (b & 31));
+            case OP_USHR:	ALU(a >> (b & 31));
+            case OP_UMUL:	ALU(a * b);
+            case OP_UMIN:	ALU((a & (il_vec_t)(a < b)) | (b & (il_vec_t)(a >= b)));
+            case OP_UMAD:	ALU(a * b + s);
+            // a:b >> (s & 31), the shift of a by 32 - (s & 31) being split in
+            // two for the case of 0
+            case OP_BITALIGN:
+                ALU((b >> (s & 31)) | ((a << 1) << (31 - (s & 31))));
+            case OP_BFI:	ALU((b & s) | (a & ~s));
+            case OP_GLOAD:
+                for (int t = 0; t < IL_BATCH; t++)
+                  {
+                    if (!exec[t])
+                        continue;
+                    uint32_t e = v[SRC(1, 0)][t] + i->off;
+                    for (int c = 0; c < 4; c++)
+                        if (i->mask & (1 << c))
+                            v[i->dst + c][t] = e < m->g_elms ?
+                                m->g[4 * e + ((i->swz[0] >> (2 * c)) & 3)] : 0;
+                  }
+                break;
+            case OP_GSTORE:
+                for (int t = 0; t < IL_BATCH; t++)
+                  {
+                    uint32_t e = v[SRC(1, 0)][t] + i->off;
+                    if (!exec[t] || e >= m->g_elms)
+                        continue;
+                    for (int c = 0; c < 4; c++)
+                        if (i->mask & (1 << c))
+                            m->g[4 * e + c] = v[SRC(0, c)][t];
+                  }
+                break;
+            case OP_UAV_ADD:
+                for (int t = 0; t < IL_BATCH; t++)
+                  {
+                    uint32_t addr = v[SRC(0, 0)][t] / 4, old = 0;
+                    if (!exec[t])
+                        continue;
+                    if (addr < m->uav1_size / 4)
+                        old = __sync_fetch_and_add(m->uav1 + addr,
+                                v[SRC(1, 0)][t]);
+                    for (int c = 0; c < 4; c++)
+                        if (i->mask & (1 << c))
+                            v[i->dst + c][t] = old;
+                  }
+                break;
+            case OP_UAV_STORE:
+                for (int t = 0; t < IL_BATCH; t++)
+                  {
+                    uint32_t addr = v[SRC(0, 0)][t] / 4;
+                    if (!exec[t])
+                        continue;
+                    for (int c = 0; c < 4; c++)
+                        if ((i->mask & (1 << c)) && addr + c < m->uav1_size / 4)
+                            m->uav1[addr + c] = v[SRC(1, c)][t];
+                  }
+                break;
+            case OP_WHILELOOP:
+                SAVED(++depth) = exec;
+                break;
+            case OP_ENDLOOP:
+                if (any(&exec))
+                  {
+                    pc = i->off;
+                    break;
+                  }
+                exec = SAVED(depth--);
+                full = all(&exec);
+                if (!any(&exec))
+                    pc = i->skip;
+                break;
+            case OP_BREAK_NZ:
+            case OP_BREAK_Z:
+                hit = exec & (il_vec_t)(v[SRC(0, 0)] != 0);
+                if (i->op == OP_BREAK_Z)
+                    hit ^= exec;
+                if (!any(&hit))
+                    break;
+                exec &= ~hit;
+                // the threads leaving the loop must not be re-enabled by the
+                // end of the ifs they leave
+                for (int d = depth; d > depth - i->off; d--)
+                    SAVED(d) &= ~hit;
+                full = false;
+                if (!any(&exec))
+                    pc = i->skip;
+                break;
+            case OP_IF_NZ:
+            case OP_IF_Z:
+                SAVED(++depth) = exec;
+                hit = exec & (il_vec_t)(v[SRC(0, 0)] != 0);
+                exec = i->op == OP_IF_NZ ? hit : hit ^ exec;
+                TAKEN(depth) = exec;
+                full = all(&exec);
+                if (!any(&exec))
+                    pc = i->off;
+                break;
+            case OP_ELSE:
+                exec = SAVED(depth) & ~TAKEN(depth);
+                full = all(&exec);
+                if (!any(&exec))
+                    pc = i->off;
+                break;
+            case OP_ENDIF:
+                exec = SAVED(depth--);
+                full = all(&exec);
+                if (!any(&exec))
+                    pc = i->skip;
+                break;
+            case OP_END:
+                return;
+          }
+      }
+}
+
+/*
+ * Runs threads first_tid to first_tid + nr_threads - 1 of k over the memories
+ * of m. If regs is not NULL, the final value of register r<reg> of each of
+ * them is copied to it.
+ */
+void il_run(const il_kernel_t *k, const il_mem_t *m, unsigned first_tid,
+        unsigned nr_threads, int reg, uint32_t (*regs)[4])
+{
+    il_vec_t *v, *stack;
+    if (posix_memalign((void **)&v, sizeof (*v), k->nr_slots * sizeof (*v)) ||
+            posix_memalign((void **)&stack, sizeof (*v),
+                (2 * k->max_depth + 1) * sizeof (*stack)))
+        perror("posix_memalign"), exit(1);
+    // literals and constants are the same for all threads
+    for (int l = 0; l < IL_NR_LITERALS; l++)
+        for (int c = 0; c < 4; c++)
+            for (int t = 0; t < IL_BATCH; t++)
+                v[4 * l + c][t] = k->lit[l][c];
+    for (int n = 0; n < 2; n++)
+        for (unsigned e = 0; e < 4 * k->cb_elms[n]; e++)
+            for (int t = 0; t < IL_BATCH; t++)
+                v[k->cb_base[n] + e][t] = e < 4 * m->cb_elms[n] ?
+                    m->cb[n][e] : 0;
+    for (unsigned first = 0; first < nr_threads; first += IL_BATCH)
+      {
+        il_vec_t exec;
+        memset(v + k->tid_base, 0, (k->nr_slots - k->tid_base) * sizeof (*v));
+        for (int t = 0; t < IL_BATCH; t++)
+          {
+            v[k->tid_base][t] = first_tid + first + t;
+            exec[t] = first + t < nr_threads ? ~0U : 0;
+          }
+        run_batch(k, m, v, stack, &exec);
+        if (!regs)
+            continue;
+        for (unsigned t = 0; t < IL_BATCH && first + t < nr_threads; t++)
+            for (int c = 0; c < 4; c++)
+                regs[first + t][c] = k->reg_base + 4 * reg + c < k->nr_slots ?
+                    v[k->reg_base + 4 * reg + c][t] : 0;
+      }
+    free(stack);
+    free(v);
+}
+
+/*
+ * Native translation: the kernel is emitted as C, one function running its
+ * threads one after the other, each register being a vector of 4 lanes (one
+ * per component), and control flow that of C. It is compiled with $CC (cc by
+ * default) into a shared object loaded with dlopen.
+ */
+
+typedef void (*il_native_fn)(uint32_t *g, unsigned g_elms,
+        const uint32_t *cb0, unsigned cb0_elms, const uint32_t *cb1,
+        unsigned cb1_elms, uint32_t *uav1, unsigned uav1_size,
+        unsigned first_tid, unsigned nr_threads, int reg,
+        uint32_t (*regs)[4]);
+
+struct il_native
+{
+    void		*dl;
+    il_native_fn	run;
+};
+
+// C expressions of the instructions, a, b and s being their sources
+static const char *const c_exprs[] = {
+    [OP_MOV] = "%s",
+    [OP_IADD] = "%s + %s",
+    [OP_ISUB] = "%s - %s",
+    [OP_IXOR] = "%s ^ %s",
+    [OP_IOR] = "%s | %s",
+    [OP_IAND] = "%s & %s",
+    [OP_INOT] = "~%s",
+    [OP_IEQ] = "(v4)(%s == %s)",
+    [OP_INE] = "(v4)(%s != %s)",
+    [OP_ISHL] = "%s << (%s & 31)",
+    [OP_USHR] = "%s >> (%s & 31)",
+    [OP_UMUL] = "%s * %s",
+    [OP_UMIN] = "umin(%s, %s)",
+    [OP_UMAD] = "%s * %s + %s",
+    [OP_BITALIGN] = "bitalign(%s, %s, %s)",
+    [OP_BFI] = "bfi(%s, %s, %s)",
+};
+
+static const char c_prologue[] =
+    "#include <stdint.h>\n"
+    "typedef uint32_t v4 __attribute__((vector_size(16)));\n"
+    "static inline v4 bitalign(v4 a, v4 b, v4 s)\n"
+    "{\n"
+    "    s &= 31;\n"
+    "    return (b >> s) | ((a << 1) << (31 - s));\n"
+    "}\n"
+    "static inline v4 bfi(v4 a, v4 b, v4 s)\n"
+    "{\n"
+    "    return (b & s) | (a & ~s);\n"
+    "}\n"
+    "static inline v4 umin(v4 a, v4 b)\n"
+    "{\n"
+    "    v4 lt = (v4)(a < b);\n"
+    "    return (a & lt) | (b & ~lt);\n"
+    "}\n"
+    "void il_native_main(uint32_t *g, unsigned g_elms,\n"
+    "        const uint32_t *cb0, unsigned cb0_elms, const uint32_t *cb1,\n"
+    "        unsigned cb1_elms, uint32_t *uav1, unsigned uav1_size,\n"
+    "        unsigned first_tid, unsigned nr_threads, int reg,\n"
+    "        uint32_t (*regs)[4])\n"
+    "{\n";
+
+/*
+ * Name of the vector of the non-literal slot base.
+ */
+static void c_name(const il_kernel_t *k, unsigned base, char name[16])
+{
+    if (base >= k->reg_base)
+        sprintf(name, "r%u", (base - k->reg_base) / 4);
+    else if (base == k->tid_base)
+        strcpy(name, "tid");
+    else if (base >= k->cb_base[1])
+        sprintf(name, "cb1_%u", (base - k->cb_base[1]) / 4);
+    else
+        sprintf(name, "cb0_%u", (base - k->cb_base[0]) / 4);
+}
+
+#define SWZ(swz, c)	(((swz) >> (2 * (c))) & 3)
+
+/*
+ * C expression of source s of i, swizzled.
+ */
+static void c_src(const il_kernel_t *k, const il_insn_t *i, int s,
+        char expr[96])
+{
+    char name[16];
+    uint8_t swz = i->swz[s];
+    if (i->src[s] < k->cb_base[0])
+      {
+        const uint32_t *l = k->lit[i->src[s] / 4];
+        sprintf(expr, "(v4){ 0x%x, 0x%x, 0x%x, 0x%x }", l[SWZ(swz, 0)],
+                l[SWZ(swz, 1)], l[SWZ(swz, 2)], l[SWZ(swz, 3)]);
+        return;
+      }
+    c_name(k, i->src[s], name);
+    if (swz == IDENTITY_SWZ)
+        strcpy(expr, name);
+    else
+        sprintf(expr, "(v4){ %s[%d], %s[%d], %s[%d], %s[%d] }", name,
+                SWZ(swz, 0), name, SWZ(swz, 1), name, SWZ(swz, 2), name,
+                SWZ(swz, 3));
+}
+
+/*
+ * C expression of component c of source s of i.
+ */
+static void c_comp(const il_kernel_t *k, const il_insn_t *i, int s, int c,
+        char expr[32])
+{
+    char name[16];
+    if (i->src[s] < k->cb_base[0])
+      {
+        sprintf(expr, "0x%xU", k->lit[i->src[s] / 4][SWZ(i->swz[s], c)]);
+        return;
+      }
+    c_name(k, i->src[s], name);
+    sprintf(expr, "%s[%d]", name, SWZ(i->swz[s], c));
+}
+
+static void c_insn(FILE *f, const il_kernel_t *k, const il_insn_t *i)
+{
+    char dst[16], a[96], b[96], s[96], x[32], y[32];
+    c_name(k, i->dst, dst);
+    c_src(k, i, 0, a);
+    c_src(k, i, 1, b);
+    c_src(k, i, 2, s);
+    c_comp(k, i, 0, 0, x);
+    c_comp(k, i, 1, 0, y);
+    switch (i->op)
+      {
+        case OP_GLOAD:
+            fprintf(f, "{ uint32_t e = %s + %d;\n", y, i->off);
+            for (int c = 0; c < 4; c++)
+                if (i->mask & (1 << c))
+                    fprintf(f, "%s[%d] = e < g_elms ? g[4 * e + %d] : 0;\n",
+                            dst, c, SWZ(i->swz[0], c));
+            fputs("}\n", f);
+            return;
+        case OP_GSTORE:
+            fprintf(f, "{ uint32_t e = %s + %d;\nif (e < g_elms) {\n", y,
+                    i->off);
+            for (int c = 0; c < 4; c++)
+                if (i->mask & (1 << c))
+                  {
+                    c_comp(k, i, 0, c, x);
+                    fprintf(f, "g[4 * e + %d] = %s;\n", c, x);
+                  }
+            fputs("} }\n", f);
+            return;
+        case OP_UAV_ADD:
+            fprintf(f, "{ uint32_t addr = %s / 4, old = 0;\n"
+                    "if (addr < uav1_size / 4)\n"
+                    "old = __sync_fetch_and_add(uav1 + addr, %s);\n", x, y);
+            for (int c = 0; c < 4; c++)
+                if (i->mask & (1 << c))
+                    fprintf(f, "%s[%d] = old;\n", dst, c);
+            fputs("}\n", f);
+            return;
+        case OP_UAV_STORE:
+            fprintf(f, "{ uint32_t addr = %s / 4;\n", x);
+            for (int c = 0; c < 4; c++)
+                if (i->mask & (1 << c))
+                  {
+                    c_comp(k, i, 1, c, y);
+                    fprintf(f, "if (addr + %d < uav1_size / 4) "
+                            "uav1[addr + %d] = %s;\n", c, c, y);
+                  }
+            fputs("}\n", f);
+            return;
+        case OP_WHILELOOP:
+            fputs("for (;;) {\n", f);
+            return;
+        case OP_ENDLOOP:
+        case OP_ENDIF:
+            fputs("}\n", f);
+            return;
+        case OP_BREAK_NZ:
+        case OP_BREAK_Z:
+            fprintf(f, "if (%s%s) break;\n", i->op == OP_BREAK_Z ? "!" : "",
+                    x);
+            return;
+        case OP_IF_NZ:
+        case OP_IF_Z:
+            fprintf(f, "if (%s%s) {\n", i->op == OP_IF_Z ? "!" : "", x);
+            return;
+        case OP_ELSE:
+            fputs("} else {\n", f);
+            return;
+        case OP_END:
+            fputs("goto done;\n", f);
+            return;
+      }
+    // a partial write mask is a blend with constant masks: the unwritten
+    // components are kept from dst
+    fprintf(f, "%s = ", dst);
+    if (i->mask != 0xf)
+      {
+        fprintf(f, "(%s & (v4){ ", dst);
+        for (int c = 0; c < 4; c++)
+            fprintf(f, "%s%s", i->mask & (1 << c) ? "0" : "~0u",
+                    c < 3 ? ", " : " }) | ((");
+      }
+    fprintf(f, c_exprs[i->op], a, b, s);
+    if (i->mask != 0xf)
+      {
+        fputs(") & (v4){ ", f);
+        for (int c = 0; c < 4; c++)
+            fprintf(f, "%s%s", i->mask & (1 << c) ? "~0u" : "0",
+                    c < 3 ? ", " : " })");
+      }
+    fputs(";\n", f);
+}
+
+/*
+ * Writes the C translation of k to f.
+ */
+static void c_kernel(FILE *f, const il_kernel_t *k)
+{
+    const unsigned nr_regs = (k->nr_slots - k->reg_base) / 4;
+    fputs(c_prologue, f);
+    for (int n = 0; n < 2; n++)
+        for (unsigned e = 0; e < k->cb_elms[n]; e++)
+            fprintf(f, "const v4 cb%d_%u = %u < cb%d_elms ? (v4){ cb%d[%u], "
+                    "cb%d[%u], cb%d[%u], cb%d[%u] } : (v4){ 0 };\n", n, e, e,
+                    n, n, 4 * e, n, 4 * e + 1, n, 4 * e + 2, n, 4 * e + 3);
+    fputs("for (unsigned n = 0; n < nr_threads; n++) {\n"
+            "v4 tid = { first_tid + n, 0, 0, 0 };\n", f);
+    for (unsigned r = 0; r < nr_regs; r++)
+        fprintf(f, "v4 r%u = { 0 };\n", r);
+    for (int pc = 0; pc < k->nr_insns; pc++)
+        c_insn(f, k, k->insns + pc);
+    fputs("done:\nif (!regs) continue;\nswitch (reg) {\n", f);
+    for (unsigned r = 0; r < nr_regs; r++)
+        fprintf(f, "case %u: for (int c = 0; c < 4; c++) regs[n][c] = r%u[c]; "
+                "break;\n", r, r);
+    fputs("}\n}\n}\n", f);
+}
+
+/*
+ * Translates k to C, compiles and loads it. Returns NULL on error, with the
+ * reason in *err (the output of the compiler goes to stderr).
+ */
+il_native_t *il_native_load(const il_kernel_t *k, const char **err)
+{
+    const char *tmp = getenv("TMPDIR"), *cc = getenv("CC");
+    char dir[PATH_MAX], src[PATH_MAX + 16], obj[PATH_MAX + 16], *cmd;
+    il_native_t *n = calloc(1, sizeof (*n));
+    FILE *f;
+    *err = "out of memory";
+    if (!n)
+        return NULL;
+    snprintf(dir, sizeof (dir), "%s/hdminer-XXXXXX", tmp ? tmp : "/tmp");
+    if (!mkdtemp(dir))
+      {
+        free(n);
+        return *err = "cannot create a temporary directory", NULL;
+      }
+    sprintf(src, "%s/kernel.c", dir);
+    sprintf(obj, "%s/kernel.so", dir);
+    if (!(f = fopen(src, "w")))
+        *err = "cannot write the C translation";
+    else
+      {
+        c_kernel(f, k);
+        if (fclose(f))
+            *err = "cannot write the C translation";
+        else if (-1 == asprintf(&cmd, "%s -std=gnu99 -O2 -march=native -fPIC -shared "
+                    "-o %s %s", cc ? cc : "cc", obj, src))
+            cmd = NULL;
+        else
+          {
+            if (system(cmd))
+                *err = "compilation of the C translation failed";
+            else if (!(n->dl = dlopen(obj, RTLD_NOW | RTLD_LOCAL)))
+                *err = "cannot load the compiled translation";
+            else if (!(n->run = (il_native_fn)(uintptr_t)dlsym(n->dl,
+                            "il_native_main")))
+                *err = "no il_native_main in the compiled translation";
+            free(cmd);
+          }
+      }
+    unlink(obj);
+    unlink(src);
+    rmdir(dir);
+    if (!n->run)
+      {
+        il_native_free(n);
+        return NULL;
+      }
+    return n;
+}
+
+/*
+ * Same as il_run, with the native translation of the kernel.
+ */
+void il_native_run(const il_native_t *n, const il_mem_t *m,
+        unsigned first_tid, unsigned nr_threads, int reg, uint32_t (*regs)[4])
+{
+    n->run(m->g, m->g_elms, m->cb[0], m->cb_elms[0], m->cb[1], m->cb_elms[1],
+            m->uav1, m->uav1_size, first_tid, nr_threads, reg, regs);
+}
+
+void il_native_free(il_native_t *n)
+{
+    if (!n)
+        return;
+    if (n->dl)
+        dlclose(n->dl);
+    free(n);
+}
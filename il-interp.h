@@ -0,0 +1,39 @@
+/*
+ * Interpreter of the AMD IL subset emitted by kernel-sha256.pl, to run the
+ * generated kernels on the host CPU and check them against the reference
+ * double hash without a GPU. The kernels can also be translated to C and
+ * compiled to native code at runtime, to run them much faster.
+ *
+ * Registers are 4-component vectors of 32-bit integers, as on the device.
+ * Threads are run in batches: each instruction is applied to all the threads
+ * of a batch, those that diverged (on if_ and break_ instructions) being
+ * masked off like on a SIMD. ibit_extract runs as BFI_INT, which is what the
+ * kernels execute once patched by patch_bfi_int_instructions.
+ */
+
+typedef struct il_kernel il_kernel_t;
+typedef struct il_native il_native_t;
+
+/*
+ * Memories of a run, in dwords. Loads past the end of one return 0, and
+ * stores past its end are dropped.
+ */
+typedef struct
+{
+    uint32_t		*g;		// g[], 4 dwords per element
+    unsigned		g_elms;
+    const uint32_t	*cb[2];		// cb0 and cb1, 4 dwords per element
+    unsigned		cb_elms[2];
+    uint32_t		*uav1;		// raw UAV, addressed in bytes
+    unsigned		uav1_size;	// in bytes
+}		il_mem_t;
+
+il_kernel_t *il_parse(const char *src, const char **err, int *line);
+unsigned il_threads_per_grp(const il_kernel_t *k);
+void il_run(const il_kernel_t *k, const il_mem_t *m, unsigned first_tid,
+        unsigned nr_threads, int reg, uint32_t (*regs)[4]);
+void il_free(il_kernel_t *k);
+il_native_t *il_native_load(const il_kernel_t *k, const char **err);
+void il_native_run(const il_native_t *n, const il_mem_t *m,
+        unsigned first_tid, unsigned nr_threads, int reg, uint32_t (*regs)[4]);
+void il_native_free(il_native_t *n);
@@ -0,0 +1,240 @@
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cal.h>
+#include <calcl.h>
+
+#include "cal-utils.h"
+#include "sha256-utils.h"
+#include "image-cache.h"
+
+/*
+ * Each image is stored in <dir>/<hex key>.img: this header followed by the
+ * bytes written by calclImageWrite. Files are written under a temporary name
+ * and renamed, so a reader never sees a partial file (devices compiling the
+ * same kernel concurrently just both write it), and are memory-mapped to be
+ * read back.
+ */
+#define IMAGE_MAGIC	"hdmimg1"
+typedef struct
+{
+    char	magic[8];
+    uint8_t	key[32];
+    uint8_t	sum[32];	// SHA-256 of the image bytes
+    uint32_t	size;		// of the image bytes
+    uint32_t	_unused;
+}		image_hdr_t;
+
+static char *cache_dir = NULL; // NULL when caching is disabled
+static int cache_verbose = 0;
+static CALuint cal_ver[3];
+
+static int mkdir_parents(char *path)
+{
+    for (char *p = path + 1; ; p++)
+      {
+        if (*p && *p != '/')
+            continue;
+        char c = *p;
+        *p = '\0';
+        int ret = mkdir(path, 0777);
+        *p = c;
+        if (ret == -1 && errno != EEXIST)
+            return -1;
+        if (!c)
+            return 0;
+      }
+}
+
+/*
+ * dir is the cache directory, NULL for the default one, or an empty string
+ * to disable caching. Must be called after calInit.
+ */
+void image_cache_init(const char *dir, int verbose)
+{
+    const char *xdg = getenv("XDG_CACHE_HOME");
+    const char *home = getenv("HOME");
+    int ret = 0;
+    cache_verbose = verbose;
+    if (CAL_RESULT_OK != calGetVersion(&cal_ver[0], &cal_ver[1], &cal_ver[2]))
+        fatal("calGetVersion");
+    if (dir)
+        ret = *dir ? asprintf(&cache_dir, "%s", dir) : 0;
+    else if (xdg && *xdg)
+        ret = asprintf(&cache_dir, "%s/hdminer", xdg);
+    else if (home && *home)
+        ret = asprintf(&cache_dir, "%s/.cache/hdminer", home);
+    if (-1 == ret)
+        perror("asprintf"), exit(1);
+    if (!cache_dir)
+        return;
+    if (mkdir_parents(cache_dir))
+      {
+        fprintf(stderr, "Warning: cannot create %s (%s), not caching kernels\n",
+                cache_dir, strerror(errno));
+        free(cache_dir);
+        cache_dir = NULL;
+        return;
+      }
+    if (verbose)
+        printf("Caching compiled kernels in %s\n", cache_dir);
+}
+
+/*
+ * Computes the key of the image of the IL src compiled for target. The IL
+ * already embeds the number of threads per group, it is hashed anyway so that
+ * changing where the kernel gets it from cannot make it pick a stale image.
+ * The iterations are not: the kernel reads them from its state table.
+ */
+void image_cache_key(uint8_t key[32], const char *src, CALtarget target,
+        unsigned threads_per_grp)
+{
+    char *buf;
+    if (-1 == asprintf(&buf, IMAGE_MAGIC " cal %u.%u.%u target %u "
+                "threads %u\n%s", cal_ver[0], cal_ver[1],
+                cal_ver[2], target, threads_per_grp, src))
+        perror("asprintf"), exit(1);
+    sha256(buf, strlen(buf), key);
+    free(buf);
+}
+
+static char *image_path(const uint8_t key[32])
+{
+    char hex[65], *path;
+    for (int i = 0; i < 32; i++)
+        sprintf(hex + 2 * i, "%02x", key[i]);
+    if (-1 == asprintf(&path, "%s/%s.img", cache_dir, hex))
+        perror("asprintf"), exit(1);
+    return path;
+}
+
+/*
+ * Looks up the image of this key. Returns false if it is not cached, or if
+ * the cached file is unusable (it is then overwritten by image_cache_add).
+ */
+bool image_cache_load(const uint8_t key[32], CALimage *img)
+{
+    const image_hdr_t *h;
+    uint8_t sum[32];
+    struct stat st;
+    bool ok = false;
+    if (!cache_dir)
+        return false;
+    char *path = image_path(key);
+    int fd = open(path, O_RDONLY);
+    if (fd == -1)
+      {
+        if (errno != ENOENT)
+            perror(path);
+        goto out;
+      }
+    if (fstat(fd, &st) == -1 || st.st_size < (off_t)sizeof (*h))
+        goto invalid;
+    h = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (h == MAP_FAILED)
+      {
+        perror("mmap");
+        goto close;
+      }
+    if (!memcmp(h->magic, IMAGE_MAGIC, sizeof (h->magic)) &&
+            !memcmp(h->key, key, sizeof (h->key)) &&
+            h->size == st.st_size - sizeof (*h))
+      {
+        sha256(h + 1, h->size, sum);
+        ok = !memcmp(h->sum, sum, sizeof (sum)) &&
+            CAL_RESULT_OK == calImageRead(img, h + 1, h->size);
+      }
+    munmap((void *)h, st.st_size);
+invalid:
+    if (!ok)
+        fprintf(stderr, "Warning: ignoring invalid cached kernel %s\n", path);
+    else if (cache_verbose)
+        printf("Loaded cached kernel %s\n", path);
+close:
+    close(fd);
+out:
+    free(path);
+    return ok;
+}
+
+static bool write_all(int fd, const void *buf, size_t len)
+{
+    const char *p = buf;
+    while (len)
+      {
+        ssize_t n = write(fd, p, len);
+        if (n == -1 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        p += n;
+        len -= n;
+      }
+    return true;
+}
+
+static void image_store(const image_hdr_t *h)
+{
+    char *path = image_path(h->key), *tmp;
+    if (-1 == asprintf(&tmp, "%s.XXXXXX", path))
+        perror("asprintf"), exit(1);
+    int fd = mkstemp(tmp);
+    if (fd == -1)
+      {
+        perror(tmp);
+        goto out;
+      }
+    bool written = write_all(fd, h, sizeof (*h) + h->size);
+    if (close(fd) == -1 || !written || rename(tmp, path) == -1)
+      {
+        fprintf(stderr, "Warning: cannot cache kernel %s (%s)\n",
+                path, strerror(errno));
+        unlink(tmp);
+      }
+    else if (cache_verbose)
+        printf("Cached kernel %s\n", path);
+out:
+    free(tmp);
+    free(path);
+}
+
+/*
+ * Caches the image freshly returned by calclLink, under this key (unless it
+ * is NULL). The linked image is freed and read back with calImageRead, so that
+ * images are always freed with calImageFree, whether they come from the cache
+ * or not.
+ */
+CALimage image_cache_add(const uint8_t key[32], CALimage linked)
+{
+    CALimage img;
+    CALuint size;
+    if (CAL_RESULT_OK != calclImageGetSize(&size, linked))
+        fatal("calclImageGetSize");
+    image_hdr_t *h = calloc(1, sizeof (*h) + size);
+    if (!h)
+        perror("calloc"), exit(1);
+    if (CAL_RESULT_OK != calclImageWrite(h + 1, size, linked))
+        fatal("calclImageWrite");
+    if (CAL_RESULT_OK != calclFreeImage(linked))
+        fatal("calclFreeImage");
+    if (cache_dir && key)
+      {
+        memcpy(h->magic, IMAGE_MAGIC, sizeof (h->magic));
+        memcpy(h->key, key, sizeof (h->key));
+        sha256(h + 1, size, h->sum);
+        h->size = size;
+        image_store(h);
+      }
+    if (CAL_RESULT_OK != calImageRead(&img, h + 1, size))
+        fatal("calImageRead");
+    free(h);
+    return img;
+}
@@ -0,0 +1,10 @@
+/*
+ * On-disk cache of linked (and BFI_INT patched) CAL images, indexed by a
+ * hash of everything the image depends on.
+ */
+
+void image_cache_init(const char *dir, int verbose);
+void image_cache_key(uint8_t key[32], const char *src, CALtarget target,
+        unsigned threads_per_grp);
+bool image_cache_load(const uint8_t key[32], CALimage *img);
+CALimage image_cache_add(const uint8_t key[32], CALimage linked);
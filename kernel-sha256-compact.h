@@ -0,0 +1,4052 @@
+#define KERNEL_SHA256_COMPACT \
+"il_cs\n\
+  dcl_num_thread_per_group %d\n\
+  ;  SHA256 round constants\n\
+  dcl_cb cb0[16]\n\
+  ;  l0.x unused\n\
+  ;  l0.y used to access g[], must be sizeof (thread_state_t) / 16\n\
+  ;  l0.z 0, used in various places\n\
+  ;  l0.w 1, used in various places\n\
+  dcl_literal l0, 0, %lu, 0, 1\n\
+  ;  l1.x value of s_found\n\
+  ;  l1.y value of s_finished\n\
+  ;  l1.z msg length in bits for second hash (ie. word 15)\n\
+  ;  l1.w s0(l1.z)\n\
+  dcl_literal l1, %d, %d, 0x100, 0x00400022\n\
+  ;  l2.x s1(l1.z)\n\
+  ;  l2.y s0(l2.z)\n\
+  ;  l2.z data word 4 (end-of-msg bit, re-used for second hash too)\n\
+  ;  l2.w data msg length in bits for first hash (ie. word 15)\n\
+  dcl_literal l2, 0x00a00000, 0x11002000, 0x80000000, 0x280\n\
+  ;  l3-l4 SHA256 intermediate hash values (for first hash)\n\
+  dcl_literal l3, %u, %u, %u, %u\n\
+  dcl_literal l4, %u, %u, %u, %u\n\
+  ;  l10-l11 A,B,C,D,E,F,G,H after step 3 of the first hash for nonce 0\n\
+  dcl_literal l10, %u, %u, %u, %u\n\
+  dcl_literal l11, %u, %u, %u, %u\n\
+  ;  l12.x-y data words 16-17 of the first hash\n\
+  ;  l12.z data word 18 minus s0(nonce)\n\
+  ;  l12.w data word 19 minus nonce\n\
+  dcl_literal l12, %u, %u, %u, %u\n\
+  ;  l13.x s0(word 16) + word 15, part of data word 31\n\
+  ;  l13.y s0(l2.w)\n\
+  dcl_literal l13, %u, 0x00a00055, 0, 0\n\
+  ;  l5-l7 rotate and shift values\n\
+  dcl_literal l5, 2, 6, 7, 17\n\
+  dcl_literal l6, 13, 11, 18, 19\n\
+  dcl_literal l7, 22, 25, 3, 10\n\
+  ;  l8-l9 SHA256 initial hash values (for second hash)\n\
+  dcl_literal l8, 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a\n\
+  dcl_literal l9, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19\n\
+  ;  uav1 result buffer: the number of candidates in its first dword, then\n\
+  ;  6 slots of 8 bytes (nonce, element index) from byte 16\n\
+  dcl_raw_uav_id(1)\n\
+  ;  l14.x byte address of the counter\n\
+  ;  l14.y last slot, re-used by the candidates overflowing\n\
+  ;  l14.z size of a slot\n\
+  ;  l14.w byte address of the first slot\n\
+  dcl_literal l14, 0, 5, 8, 16\n\
+  ;  l15 element index of each component, minus 4 * thread index\n\
+  dcl_literal l15, 0, 1, 2, 3\n\
+\n\
+  ; r0.x    offset to this thread's state in g[]\n\
+  ; r0.y    iteration counter\n\
+  ; r0.z    number of iterations, set by the host in the table of each run\n\
+  ; r1-r8   A,B,C,D,E,F,G,H\n\
+  ; r9-r24  16 data words, re-used to process all 64 data words\n\
+  ; r73     current nonce\n\
+  ; r74     end nonce\n\
+  ; r79     components still scanning\n\
+  ; r80     byte address of the slot of a candidate\n\
+  ; r81     candidate (nonce, element index)\n\
+  ; r75   temp value\n\
+  ; r76   temp value\n\
+  ; r77   temp value\n\
+  ; r78   temp value\n\
+\n\
+  umul r0.x, vAbsTidFlat.x, l0.y\n\
+  mov r0.z, g[r0.x+0].w\n\
+\n\
+  ; load current nonce\n\
+  mov r73.x, g[r0.x+0].y\n\
+  mov r73.y, g[r0.x+1].y\n\
+  mov r73.z, g[r0.x+2].y\n\
+  mov r73.w, g[r0.x+3].y\n\
+  ; load end nonce\n\
+  mov r74.x, g[r0.x+0].z\n\
+  mov r74.y, g[r0.x+1].z\n\
+  mov r74.z, g[r0.x+2].z\n\
+  mov r74.w, g[r0.x+3].z\n\
+\n\
+  ixor r0.y, r0.y, r0.y\n\
+\n\
+  whileloop\n\
+    ; set bits in r79 for the components that did not reach their end\n\
+    ; nonce, and break if there is none\n\
+    ine r79, r73, r74\n\
+    ior r75.xy, r79.xy, r79.zw\n\
+    ior r75.x, r75.x, r75.y\n\
+    break_logicalz r75.x\n\
+\n\
+    ; data words 0-15 are not loaded: words 0-3 were used by steps 0-3\n\
+    ; (precomputed), and words 4-15 are literals\n\
+\n\
+    ; init intermediate hash values from the state after step 3, named as\n\
+    ; they are used by step 4; the nonce (word 3) adds to A and E\n\
+    iadd r5, l10.xxxx, r73\n\
+    mov r6, l10.yyyy\n\
+    mov r7, l10.zzzz\n\
+    mov r8, l10.wwww\n\
+    iadd r1, l11.xxxx, r73\n\
+    mov r2, l11.yyyy\n\
+    mov r3, l11.zzzz\n\
+    mov r4, l11.wwww\n\
+\n\
+\n\
+    ; step 4\n\
+    bitalign r75, r5, r5, l5.xxxx\n\
+    bitalign r76, r5, r5, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r5, r5, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r5, r6\n\
+    ibit_extract r75, r5, r7, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r1, r1, l5.yyyy\n\
+    bitalign r76, r1, r1, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r1, r1, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r3, r2, r1\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r4\n\
+    iadd r75, r75, cb0[1].xxxx\n\
+    iadd r76, r75, l2.zzzz\n\
+    iadd r8, r8, r76\n\
+    iadd r4, r76, r77\n\
+\n\
+    ; step 5\n\
+    bitalign r75, r4, r4, l5.xxxx\n\
+    bitalign r76, r4, r4, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r4, r4, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r4, r5\n\
+    ibit_extract r75, r4, r6, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r8, r8, l5.yyyy\n\
+    bitalign r76, r8, r8, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r8, r8, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r2, r1, r8\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r3\n\
+    iadd r76, r75, cb0[1].yyyy\n\
+    iadd r7, r7, r76\n\
+    iadd r3, r76, r77\n\
+\n\
+    ; step 6\n\
+    bitalign r75, r3, r3, l5.xxxx\n\
+    bitalign r76, r3, r3, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r3, r3, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r3, r4\n\
+    ibit_extract r75, r3, r5, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r7, r7, l5.yyyy\n\
+    bitalign r76, r7, r7, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r7, r7, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r1, r8, r7\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r2\n\
+    iadd r76, r75, cb0[1].zzzz\n\
+    iadd r6, r6, r76\n\
+    iadd r2, r76, r77\n\
+\n\
+    ; step 7\n\
+    bitalign r75, r2, r2, l5.xxxx\n\
+    bitalign r76, r2, r2, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r2, r2, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r2, r3\n\
+    ibit_extract r75, r2, r4, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r6, r6, l5.yyyy\n\
+    bitalign r76, r6, r6, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r6, r6, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r8, r7, r6\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r1\n\
+    iadd r76, r75, cb0[1].wwww\n\
+    iadd r5, r5, r76\n\
+    iadd r1, r76, r77\n\
+\n\
+    ; step 8\n\
+    bitalign r75, r1, r1, l5.xxxx\n\
+    bitalign r76, r1, r1, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r1, r1, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r1, r2\n\
+    ibit_extract r75, r1, r3, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r5, r5, l5.yyyy\n\
+    bitalign r76, r5, r5, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r5, r5, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r7, r6, r5\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r8\n\
+    iadd r76, r75, cb0[2].xxxx\n\
+    iadd r4, r4, r76\n\
+    iadd r8, r76, r77\n\
+\n\
+    ; step 9\n\
+    bitalign r75, r8, r8, l5.xxxx\n\
+    bitalign r76, r8, r8, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r8, r8, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r8, r1\n\
+    ibit_extract r75, r8, r2, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r4, r4, l5.yyyy\n\
+    bitalign r76, r4, r4, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r4, r4, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r6, r5, r4\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r7\n\
+    iadd r76, r75, cb0[2].yyyy\n\
+    iadd r3, r3, r76\n\
+    iadd r7, r76, r77\n\
+\n\
+    ; step 10\n\
+    bitalign r75, r7, r7, l5.xxxx\n\
+    bitalign r76, r7, r7, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r7, r7, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r7, r8\n\
+    ibit_extract r75, r7, r1, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r3, r3, l5.yyyy\n\
+    bitalign r76, r3, r3, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r3, r3, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r5, r4, r3\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r6\n\
+    iadd r76, r75, cb0[2].zzzz\n\
+    iadd r2, r2, r76\n\
+    iadd r6, r76, r77\n\
+\n\
+    ; step 11\n\
+    bitalign r75, r6, r6, l5.xxxx\n\
+    bitalign r76, r6, r6, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r6, r6, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r6, r7\n\
+    ibit_extract r75, r6, r8, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r2, r2, l5.yyyy\n\
+    bitalign r76, r2, r2, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r2, r2, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r4, r3, r2\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r5\n\
+    iadd r76, r75, cb0[2].wwww\n\
+    iadd r1, r1, r76\n\
+    iadd r5, r76, r77\n\
+\n\
+    ; step 12\n\
+    bitalign r75, r5, r5, l5.xxxx\n\
+    bitalign r76, r5, r5, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r5, r5, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r5, r6\n\
+    ibit_extract r75, r5, r7, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r1, r1, l5.yyyy\n\
+    bitalign r76, r1, r1, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r1, r1, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r3, r2, r1\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r4\n\
+    iadd r76, r75, cb0[3].xxxx\n\
+    iadd r8, r8, r76\n\
+    iadd r4, r76, r77\n\
+\n\
+    ; step 13\n\
+    bitalign r75, r4, r4, l5.xxxx\n\
+    bitalign r76, r4, r4, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r4, r4, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r4, r5\n\
+    ibit_extract r75, r4, r6, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r8, r8, l5.yyyy\n\
+    bitalign r76, r8, r8, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r8, r8, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r2, r1, r8\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r3\n\
+    iadd r76, r75, cb0[3].yyyy\n\
+    iadd r7, r7, r76\n\
+    iadd r3, r76, r77\n\
+\n\
+    ; step 14\n\
+    bitalign r75, r3, r3, l5.xxxx\n\
+    bitalign r76, r3, r3, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r3, r3, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r3, r4\n\
+    ibit_extract r75, r3, r5, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r7, r7, l5.yyyy\n\
+    bitalign r76, r7, r7, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r7, r7, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r1, r8, r7\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r2\n\
+    iadd r76, r75, cb0[3].zzzz\n\
+    iadd r6, r6, r76\n\
+    iadd r2, r76, r77\n\
+\n\
+    ; step 15\n\
+    bitalign r75, r2, r2, l5.xxxx\n\
+    bitalign r76, r2, r2, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r2, r2, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r2, r3\n\
+    ibit_extract r75, r2, r4, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r6, r6, l5.yyyy\n\
+    bitalign r76, r6, r6, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r6, r6, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r8, r7, r6\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r1\n\
+    iadd r75, r75, cb0[3].wwww\n\
+    iadd r76, r75, l2.wwww\n\
+    iadd r5, r5, r76\n\
+    iadd r1, r76, r77\n\
+\n\
+    ; blend word 16\n\
+    mov r9, l12.xxxx\n\
+\n\
+    ; step 16\n\
+    bitalign r75, r1, r1, l5.xxxx\n\
+    bitalign r76, r1, r1, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r1, r1, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r1, r2\n\
+    ibit_extract r75, r1, r3, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r5, r5, l5.yyyy\n\
+    bitalign r76, r5, r5, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r5, r5, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r7, r6, r5\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r8\n\
+    iadd r75, r75, cb0[4].xxxx\n\
+    iadd r76, r75, r9\n\
+    iadd r4, r4, r76\n\
+    iadd r8, r76, r77\n\
+\n\
+    ; blend word 17\n\
+    mov r10, l12.yyyy\n\
+\n\
+    ; step 17\n\
+    bitalign r75, r8, r8, l5.xxxx\n\
+    bitalign r76, r8, r8, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r8, r8, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r8, r1\n\
+    ibit_extract r75, r8, r2, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r4, r4, l5.yyyy\n\
+    bitalign r76, r4, r4, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r4, r4, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r6, r5, r4\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r7\n\
+    iadd r75, r75, cb0[4].yyyy\n\
+    iadd r76, r75, r10\n\
+    iadd r3, r3, r76\n\
+    iadd r7, r76, r77\n\
+\n\
+    ; blend word 18\n\
+    bitalign r75, r73, r73, l5.zzzz\n\
+    bitalign r76, r73, r73, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r73, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    iadd r11, r77, l12.zzzz\n\
+\n\
+    ; step 18\n\
+    bitalign r75, r7, r7, l5.xxxx\n\
+    bitalign r76, r7, r7, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r7, r7, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r7, r8\n\
+    ibit_extract r75, r7, r1, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r3, r3, l5.yyyy\n\
+    bitalign r76, r3, r3, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r3, r3, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r5, r4, r3\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r6\n\
+    iadd r75, r75, cb0[4].zzzz\n\
+    iadd r76, r75, r11\n\
+    iadd r2, r2, r76\n\
+    iadd r6, r76, r77\n\
+\n\
+    ; blend word 19\n\
+    iadd r12, r73, l12.wwww\n\
+\n\
+    ; step 19\n\
+    bitalign r75, r6, r6, l5.xxxx\n\
+    bitalign r76, r6, r6, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r6, r6, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r6, r7\n\
+    ibit_extract r75, r6, r8, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r2, r2, l5.yyyy\n\
+    bitalign r76, r2, r2, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r2, r2, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r4, r3, r2\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r5\n\
+    iadd r75, r75, cb0[4].wwww\n\
+    iadd r76, r75, r12\n\
+    iadd r1, r1, r76\n\
+    iadd r5, r76, r77\n\
+\n\
+    ; blend word 20\n\
+    bitalign r76, r11, r11, l5.wwww\n\
+    bitalign r75, r11, r11, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r11, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r13, r76, l2.zzzz\n\
+\n\
+    ; step 20\n\
+    bitalign r75, r5, r5, l5.xxxx\n\
+    bitalign r76, r5, r5, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r5, r5, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r5, r6\n\
+    ibit_extract r75, r5, r7, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r1, r1, l5.yyyy\n\
+    bitalign r76, r1, r1, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r1, r1, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r3, r2, r1\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r4\n\
+    iadd r75, r75, cb0[5].xxxx\n\
+    iadd r76, r75, r13\n\
+    iadd r8, r8, r76\n\
+    iadd r4, r76, r77\n\
+\n\
+    ; blend word 21\n\
+    bitalign r76, r12, r12, l5.wwww\n\
+    bitalign r75, r12, r12, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r12, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    mov r14, r76\n\
+\n\
+    ; step 21\n\
+    bitalign r75, r4, r4, l5.xxxx\n\
+    bitalign r76, r4, r4, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r4, r4, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r4, r5\n\
+    ibit_extract r75, r4, r6, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r8, r8, l5.yyyy\n\
+    bitalign r76, r8, r8, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r8, r8, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r2, r1, r8\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r3\n\
+    iadd r75, r75, cb0[5].yyyy\n\
+    iadd r76, r75, r14\n\
+    iadd r7, r7, r76\n\
+    iadd r3, r76, r77\n\
+\n\
+    ; blend word 22\n\
+    bitalign r76, r13, r13, l5.wwww\n\
+    bitalign r75, r13, r13, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r13, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r15, r76, l2.wwww\n\
+\n\
+    ; step 22\n\
+    bitalign r75, r3, r3, l5.xxxx\n\
+    bitalign r76, r3, r3, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r3, r3, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r3, r4\n\
+    ibit_extract r75, r3, r5, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r7, r7, l5.yyyy\n\
+    bitalign r76, r7, r7, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r7, r7, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r1, r8, r7\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r2\n\
+    iadd r75, r75, cb0[5].zzzz\n\
+    iadd r76, r75, r15\n\
+    iadd r6, r6, r76\n\
+    iadd r2, r76, r77\n\
+\n\
+    ; blend word 23\n\
+    bitalign r76, r14, r14, l5.wwww\n\
+    bitalign r75, r14, r14, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r14, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r16, r76, r9\n\
+\n\
+    ; step 23\n\
+    bitalign r75, r2, r2, l5.xxxx\n\
+    bitalign r76, r2, r2, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r2, r2, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r2, r3\n\
+    ibit_extract r75, r2, r4, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r6, r6, l5.yyyy\n\
+    bitalign r76, r6, r6, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r6, r6, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r8, r7, r6\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r1\n\
+    iadd r75, r75, cb0[5].wwww\n\
+    iadd r76, r75, r16\n\
+    iadd r5, r5, r76\n\
+    iadd r1, r76, r77\n\
+\n\
+    ; blend word 24\n\
+    bitalign r76, r15, r15, l5.wwww\n\
+    bitalign r75, r15, r15, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r15, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r17, r76, r10\n\
+\n\
+    ; step 24\n\
+    bitalign r75, r1, r1, l5.xxxx\n\
+    bitalign r76, r1, r1, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r1, r1, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r1, r2\n\
+    ibit_extract r75, r1, r3, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r5, r5, l5.yyyy\n\
+    bitalign r76, r5, r5, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r5, r5, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r7, r6, r5\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r8\n\
+    iadd r75, r75, cb0[6].xxxx\n\
+    iadd r76, r75, r17\n\
+    iadd r4, r4, r76\n\
+    iadd r8, r76, r77\n\
+\n\
+    ; blend word 25\n\
+    bitalign r76, r16, r16, l5.wwww\n\
+    bitalign r75, r16, r16, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r16, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r18, r76, r11\n\
+\n\
+    ; step 25\n\
+    bitalign r75, r8, r8, l5.xxxx\n\
+    bitalign r76, r8, r8, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r8, r8, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r8, r1\n\
+    ibit_extract r75, r8, r2, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r4, r4, l5.yyyy\n\
+    bitalign r76, r4, r4, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r4, r4, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r6, r5, r4\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r7\n\
+    iadd r75, r75, cb0[6].yyyy\n\
+    iadd r76, r75, r18\n\
+    iadd r3, r3, r76\n\
+    iadd r7, r76, r77\n\
+\n\
+    ; blend word 26\n\
+    bitalign r76, r17, r17, l5.wwww\n\
+    bitalign r75, r17, r17, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r17, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r19, r76, r12\n\
+\n\
+    ; step 26\n\
+    bitalign r75, r7, r7, l5.xxxx\n\
+    bitalign r76, r7, r7, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r7, r7, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r7, r8\n\
+    ibit_extract r75, r7, r1, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r3, r3, l5.yyyy\n\
+    bitalign r76, r3, r3, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r3, r3, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r5, r4, r3\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r6\n\
+    iadd r75, r75, cb0[6].zzzz\n\
+    iadd r76, r75, r19\n\
+    iadd r2, r2, r76\n\
+    iadd r6, r76, r77\n\
+\n\
+    ; blend word 27\n\
+    bitalign r76, r18, r18, l5.wwww\n\
+    bitalign r75, r18, r18, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r18, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r20, r76, r13\n\
+\n\
+    ; step 27\n\
+    bitalign r75, r6, r6, l5.xxxx\n\
+    bitalign r76, r6, r6, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r6, r6, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r6, r7\n\
+    ibit_extract r75, r6, r8, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r2, r2, l5.yyyy\n\
+    bitalign r76, r2, r2, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r2, r2, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r4, r3, r2\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r5\n\
+    iadd r75, r75, cb0[6].wwww\n\
+    iadd r76, r75, r20\n\
+    iadd r1, r1, r76\n\
+    iadd r5, r76, r77\n\
+\n\
+    ; blend word 28\n\
+    bitalign r76, r19, r19, l5.wwww\n\
+    bitalign r75, r19, r19, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r19, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r21, r76, r14\n\
+\n\
+    ; step 28\n\
+    bitalign r75, r5, r5, l5.xxxx\n\
+    bitalign r76, r5, r5, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r5, r5, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r5, r6\n\
+    ibit_extract r75, r5, r7, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r1, r1, l5.yyyy\n\
+    bitalign r76, r1, r1, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r1, r1, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r3, r2, r1\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r4\n\
+    iadd r75, r75, cb0[7].xxxx\n\
+    iadd r76, r75, r21\n\
+    iadd r8, r8, r76\n\
+    iadd r4, r76, r77\n\
+\n\
+    ; blend word 29\n\
+    bitalign r76, r20, r20, l5.wwww\n\
+    bitalign r75, r20, r20, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r20, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r22, r76, r15\n\
+\n\
+    ; step 29\n\
+    bitalign r75, r4, r4, l5.xxxx\n\
+    bitalign r76, r4, r4, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r4, r4, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r4, r5\n\
+    ibit_extract r75, r4, r6, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r8, r8, l5.yyyy\n\
+    bitalign r76, r8, r8, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r8, r8, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r2, r1, r8\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r3\n\
+    iadd r75, r75, cb0[7].yyyy\n\
+    iadd r76, r75, r22\n\
+    iadd r7, r7, r76\n\
+    iadd r3, r76, r77\n\
+\n\
+    ; blend word 30\n\
+    bitalign r76, r21, r21, l5.wwww\n\
+    bitalign r75, r21, r21, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r21, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r76, r16\n\
+    iadd r23, r75, l13.yyyy\n\
+\n\
+    ; step 30\n\
+    bitalign r75, r3, r3, l5.xxxx\n\
+    bitalign r76, r3, r3, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r3, r3, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r3, r4\n\
+    ibit_extract r75, r3, r5, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r7, r7, l5.yyyy\n\
+    bitalign r76, r7, r7, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r7, r7, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r1, r8, r7\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r2\n\
+    iadd r75, r75, cb0[7].zzzz\n\
+    iadd r76, r75, r23\n\
+    iadd r6, r6, r76\n\
+    iadd r2, r76, r77\n\
+\n\
+    ; blend word 31\n\
+    bitalign r76, r22, r22, l5.wwww\n\
+    bitalign r75, r22, r22, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r22, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r76, r17\n\
+    iadd r24, r75, l13.xxxx\n\
+\n\
+    ; step 31\n\
+    bitalign r75, r2, r2, l5.xxxx\n\
+    bitalign r76, r2, r2, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r2, r2, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r2, r3\n\
+    ibit_extract r75, r2, r4, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r6, r6, l5.yyyy\n\
+    bitalign r76, r6, r6, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r6, r6, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r8, r7, r6\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r1\n\
+    iadd r75, r75, cb0[7].wwww\n\
+    iadd r76, r75, r24\n\
+    iadd r5, r5, r76\n\
+    iadd r1, r76, r77\n\
+\n\
+    ; blend word 32\n\
+    bitalign r75, r10, r10, l5.zzzz\n\
+    bitalign r76, r10, r10, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r10, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r23, r23, l5.wwww\n\
+    bitalign r75, r23, r23, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r23, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r9\n\
+    iadd r9, r75, r18\n\
+\n\
+    ; step 32\n\
+    bitalign r75, r1, r1, l5.xxxx\n\
+    bitalign r76, r1, r1, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r1, r1, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r1, r2\n\
+    ibit_extract r75, r1, r3, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r5, r5, l5.yyyy\n\
+    bitalign r76, r5, r5, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r5, r5, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r7, r6, r5\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r8\n\
+    iadd r75, r75, cb0[8].xxxx\n\
+    iadd r76, r75, r9\n\
+    iadd r4, r4, r76\n\
+    iadd r8, r76, r77\n\
+\n\
+    ; blend word 33\n\
+    bitalign r75, r11, r11, l5.zzzz\n\
+    bitalign r76, r11, r11, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r11, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r24, r24, l5.wwww\n\
+    bitalign r75, r24, r24, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r24, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r10\n\
+    iadd r10, r75, r19\n\
+\n\
+    ; step 33\n\
+    bitalign r75, r8, r8, l5.xxxx\n\
+    bitalign r76, r8, r8, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r8, r8, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r8, r1\n\
+    ibit_extract r75, r8, r2, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r4, r4, l5.yyyy\n\
+    bitalign r76, r4, r4, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r4, r4, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r6, r5, r4\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r7\n\
+    iadd r75, r75, cb0[8].yyyy\n\
+    iadd r76, r75, r10\n\
+    iadd r3, r3, r76\n\
+    iadd r7, r76, r77\n\
+\n\
+    ; blend word 34\n\
+    bitalign r75, r12, r12, l5.zzzz\n\
+    bitalign r76, r12, r12, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r12, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r9, r9, l5.wwww\n\
+    bitalign r75, r9, r9, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r9, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r11\n\
+    iadd r11, r75, r20\n\
+\n\
+    ; step 34\n\
+    bitalign r75, r7, r7, l5.xxxx\n\
+    bitalign r76, r7, r7, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r7, r7, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r7, r8\n\
+    ibit_extract r75, r7, r1, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r3, r3, l5.yyyy\n\
+    bitalign r76, r3, r3, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r3, r3, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r5, r4, r3\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r6\n\
+    iadd r75, r75, cb0[8].zzzz\n\
+    iadd r76, r75, r11\n\
+    iadd r2, r2, r76\n\
+    iadd r6, r76, r77\n\
+\n\
+    ; blend word 35\n\
+    bitalign r75, r13, r13, l5.zzzz\n\
+    bitalign r76, r13, r13, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r13, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r10, r10, l5.wwww\n\
+    bitalign r75, r10, r10, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r10, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r12\n\
+    iadd r12, r75, r21\n\
+\n\
+    ; step 35\n\
+    bitalign r75, r6, r6, l5.xxxx\n\
+    bitalign r76, r6, r6, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r6, r6, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r6, r7\n\
+    ibit_extract r75, r6, r8, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r2, r2, l5.yyyy\n\
+    bitalign r76, r2, r2, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r2, r2, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r4, r3, r2\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r5\n\
+    iadd r75, r75, cb0[8].wwww\n\
+    iadd r76, r75, r12\n\
+    iadd r1, r1, r76\n\
+    iadd r5, r76, r77\n\
+\n\
+    ; blend word 36\n\
+    bitalign r75, r14, r14, l5.zzzz\n\
+    bitalign r76, r14, r14, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r14, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r11, r11, l5.wwww\n\
+    bitalign r75, r11, r11, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r11, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r13\n\
+    iadd r13, r75, r22\n\
+\n\
+    ; step 36\n\
+    bitalign r75, r5, r5, l5.xxxx\n\
+    bitalign r76, r5, r5, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r5, r5, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r5, r6\n\
+    ibit_extract r75, r5, r7, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r1, r1, l5.yyyy\n\
+    bitalign r76, r1, r1, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r1, r1, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r3, r2, r1\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r4\n\
+    iadd r75, r75, cb0[9].xxxx\n\
+    iadd r76, r75, r13\n\
+    iadd r8, r8, r76\n\
+    iadd r4, r76, r77\n\
+\n\
+    ; blend word 37\n\
+    bitalign r75, r15, r15, l5.zzzz\n\
+    bitalign r76, r15, r15, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r15, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r12, r12, l5.wwww\n\
+    bitalign r75, r12, r12, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r12, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r14\n\
+    iadd r14, r75, r23\n\
+\n\
+    ; step 37\n\
+    bitalign r75, r4, r4, l5.xxxx\n\
+    bitalign r76, r4, r4, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r4, r4, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r4, r5\n\
+    ibit_extract r75, r4, r6, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r8, r8, l5.yyyy\n\
+    bitalign r76, r8, r8, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r8, r8, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r2, r1, r8\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r3\n\
+    iadd r75, r75, cb0[9].yyyy\n\
+    iadd r76, r75, r14\n\
+    iadd r7, r7, r76\n\
+    iadd r3, r76, r77\n\
+\n\
+    ; blend word 38\n\
+    bitalign r75, r16, r16, l5.zzzz\n\
+    bitalign r76, r16, r16, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r16, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r13, r13, l5.wwww\n\
+    bitalign r75, r13, r13, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r13, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r15\n\
+    iadd r15, r75, r24\n\
+\n\
+    ; step 38\n\
+    bitalign r75, r3, r3, l5.xxxx\n\
+    bitalign r76, r3, r3, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r3, r3, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r3, r4\n\
+    ibit_extract r75, r3, r5, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r7, r7, l5.yyyy\n\
+    bitalign r76, r7, r7, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r7, r7, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r1, r8, r7\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r2\n\
+    iadd r75, r75, cb0[9].zzzz\n\
+    iadd r76, r75, r15\n\
+    iadd r6, r6, r76\n\
+    iadd r2, r76, r77\n\
+\n\
+    ; blend word 39\n\
+    bitalign r75, r17, r17, l5.zzzz\n\
+    bitalign r76, r17, r17, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r17, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r14, r14, l5.wwww\n\
+    bitalign r75, r14, r14, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r14, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r16\n\
+    iadd r16, r75, r9\n\
+\n\
+    ; step 39\n\
+    bitalign r75, r2, r2, l5.xxxx\n\
+    bitalign r76, r2, r2, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r2, r2, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r2, r3\n\
+    ibit_extract r75, r2, r4, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r6, r6, l5.yyyy\n\
+    bitalign r76, r6, r6, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r6, r6, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r8, r7, r6\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r1\n\
+    iadd r75, r75, cb0[9].wwww\n\
+    iadd r76, r75, r16\n\
+    iadd r5, r5, r76\n\
+    iadd r1, r76, r77\n\
+\n\
+    ; blend word 40\n\
+    bitalign r75, r18, r18, l5.zzzz\n\
+    bitalign r76, r18, r18, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r18, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r15, r15, l5.wwww\n\
+    bitalign r75, r15, r15, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r15, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r17\n\
+    iadd r17, r75, r10\n\
+\n\
+    ; step 40\n\
+    bitalign r75, r1, r1, l5.xxxx\n\
+    bitalign r76, r1, r1, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r1, r1, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r1, r2\n\
+    ibit_extract r75, r1, r3, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r5, r5, l5.yyyy\n\
+    bitalign r76, r5, r5, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r5, r5, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r7, r6, r5\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r8\n\
+    iadd r75, r75, cb0[10].xxxx\n\
+    iadd r76, r75, r17\n\
+    iadd r4, r4, r76\n\
+    iadd r8, r76, r77\n\
+\n\
+    ; blend word 41\n\
+    bitalign r75, r19, r19, l5.zzzz\n\
+    bitalign r76, r19, r19, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r19, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r16, r16, l5.wwww\n\
+    bitalign r75, r16, r16, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r16, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r18\n\
+    iadd r18, r75, r11\n\
+\n\
+    ; step 41\n\
+    bitalign r75, r8, r8, l5.xxxx\n\
+    bitalign r76, r8, r8, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r8, r8, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r8, r1\n\
+    ibit_extract r75, r8, r2, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r4, r4, l5.yyyy\n\
+    bitalign r76, r4, r4, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r4, r4, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r6, r5, r4\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r7\n\
+    iadd r75, r75, cb0[10].yyyy\n\
+    iadd r76, r75, r18\n\
+    iadd r3, r3, r76\n\
+    iadd r7, r76, r77\n\
+\n\
+    ; blend word 42\n\
+    bitalign r75, r20, r20, l5.zzzz\n\
+    bitalign r76, r20, r20, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r20, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r17, r17, l5.wwww\n\
+    bitalign r75, r17, r17, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r17, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r19\n\
+    iadd r19, r75, r12\n\
+\n\
+    ; step 42\n\
+    bitalign r75, r7, r7, l5.xxxx\n\
+    bitalign r76, r7, r7, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r7, r7, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r7, r8\n\
+    ibit_extract r75, r7, r1, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r3, r3, l5.yyyy\n\
+    bitalign r76, r3, r3, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r3, r3, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r5, r4, r3\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r6\n\
+    iadd r75, r75, cb0[10].zzzz\n\
+    iadd r76, r75, r19\n\
+    iadd r2, r2, r76\n\
+    iadd r6, r76, r77\n\
+\n\
+    ; blend word 43\n\
+    bitalign r75, r21, r21, l5.zzzz\n\
+    bitalign r76, r21, r21, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r21, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r18, r18, l5.wwww\n\
+    bitalign r75, r18, r18, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r18, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r20\n\
+    iadd r20, r75, r13\n\
+\n\
+    ; step 43\n\
+    bitalign r75, r6, r6, l5.xxxx\n\
+    bitalign r76, r6, r6, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r6, r6, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r6, r7\n\
+    ibit_extract r75, r6, r8, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r2, r2, l5.yyyy\n\
+    bitalign r76, r2, r2, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r2, r2, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r4, r3, r2\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r5\n\
+    iadd r75, r75, cb0[10].wwww\n\
+    iadd r76, r75, r20\n\
+    iadd r1, r1, r76\n\
+    iadd r5, r76, r77\n\
+\n\
+    ; blend word 44\n\
+    bitalign r75, r22, r22, l5.zzzz\n\
+    bitalign r76, r22, r22, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r22, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r19, r19, l5.wwww\n\
+    bitalign r75, r19, r19, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r19, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r21\n\
+    iadd r21, r75, r14\n\
+\n\
+    ; step 44\n\
+    bitalign r75, r5, r5, l5.xxxx\n\
+    bitalign r76, r5, r5, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r5, r5, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r5, r6\n\
+    ibit_extract r75, r5, r7, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r1, r1, l5.yyyy\n\
+    bitalign r76, r1, r1, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r1, r1, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r3, r2, r1\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r4\n\
+    iadd r75, r75, cb0[11].xxxx\n\
+    iadd r76, r75, r21\n\
+    iadd r8, r8, r76\n\
+    iadd r4, r76, r77\n\
+\n\
+    ; blend word 45\n\
+    bitalign r75, r23, r23, l5.zzzz\n\
+    bitalign r76, r23, r23, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r23, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r20, r20, l5.wwww\n\
+    bitalign r75, r20, r20, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r20, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r22\n\
+    iadd r22, r75, r15\n\
+\n\
+    ; step 45\n\
+    bitalign r75, r4, r4, l5.xxxx\n\
+    bitalign r76, r4, r4, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r4, r4, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r4, r5\n\
+    ibit_extract r75, r4, r6, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r8, r8, l5.yyyy\n\
+    bitalign r76, r8, r8, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r8, r8, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r2, r1, r8\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r3\n\
+    iadd r75, r75, cb0[11].yyyy\n\
+    iadd r76, r75, r22\n\
+    iadd r7, r7, r76\n\
+    iadd r3, r76, r77\n\
+\n\
+    ; blend word 46\n\
+    bitalign r75, r24, r24, l5.zzzz\n\
+    bitalign r76, r24, r24, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r24, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r21, r21, l5.wwww\n\
+    bitalign r75, r21, r21, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r21, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r23\n\
+    iadd r23, r75, r16\n\
+\n\
+    ; step 46\n\
+    bitalign r75, r3, r3, l5.xxxx\n\
+    bitalign r76, r3, r3, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r3, r3, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r3, r4\n\
+    ibit_extract r75, r3, r5, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r7, r7, l5.yyyy\n\
+    bitalign r76, r7, r7, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r7, r7, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r1, r8, r7\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r2\n\
+    iadd r75, r75, cb0[11].zzzz\n\
+    iadd r76, r75, r23\n\
+    iadd r6, r6, r76\n\
+    iadd r2, r76, r77\n\
+\n\
+    ; blend word 47\n\
+    bitalign r75, r9, r9, l5.zzzz\n\
+    bitalign r76, r9, r9, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r9, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r22, r22, l5.wwww\n\
+    bitalign r75, r22, r22, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r22, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r24\n\
+    iadd r24, r75, r17\n\
+\n\
+    ; step 47\n\
+    bitalign r75, r2, r2, l5.xxxx\n\
+    bitalign r76, r2, r2, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r2, r2, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r2, r3\n\
+    ibit_extract r75, r2, r4, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r6, r6, l5.yyyy\n\
+    bitalign r76, r6, r6, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r6, r6, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r8, r7, r6\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r1\n\
+    iadd r75, r75, cb0[11].wwww\n\
+    iadd r76, r75, r24\n\
+    iadd r5, r5, r76\n\
+    iadd r1, r76, r77\n\
+\n\
+    ; blend word 48\n\
+    bitalign r75, r10, r10, l5.zzzz\n\
+    bitalign r76, r10, r10, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r10, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r23, r23, l5.wwww\n\
+    bitalign r75, r23, r23, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r23, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r9\n\
+    iadd r9, r75, r18\n\
+\n\
+    ; step 48\n\
+    bitalign r75, r1, r1, l5.xxxx\n\
+    bitalign r76, r1, r1, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r1, r1, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r1, r2\n\
+    ibit_extract r75, r1, r3, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r5, r5, l5.yyyy\n\
+    bitalign r76, r5, r5, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r5, r5, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r7, r6, r5\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r8\n\
+    iadd r75, r75, cb0[12].xxxx\n\
+    iadd r76, r75, r9\n\
+    iadd r4, r4, r76\n\
+    iadd r8, r76, r77\n\
+\n\
+    ; blend word 49\n\
+    bitalign r75, r11, r11, l5.zzzz\n\
+    bitalign r76, r11, r11, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r11, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r24, r24, l5.wwww\n\
+    bitalign r75, r24, r24, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r24, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r10\n\
+    iadd r10, r75, r19\n\
+\n\
+    ; step 49\n\
+    bitalign r75, r8, r8, l5.xxxx\n\
+    bitalign r76, r8, r8, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r8, r8, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r8, r1\n\
+    ibit_extract r75, r8, r2, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r4, r4, l5.yyyy\n\
+    bitalign r76, r4, r4, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r4, r4, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r6, r5, r4\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r7\n\
+    iadd r75, r75, cb0[12].yyyy\n\
+    iadd r76, r75, r10\n\
+    iadd r3, r3, r76\n\
+    iadd r7, r76, r77\n\
+\n\
+    ; blend word 50\n\
+    bitalign r75, r12, r12, l5.zzzz\n\
+    bitalign r76, r12, r12, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r12, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r9, r9, l5.wwww\n\
+    bitalign r75, r9, r9, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r9, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r11\n\
+    iadd r11, r75, r20\n\
+\n\
+    ; step 50\n\
+    bitalign r75, r7, r7, l5.xxxx\n\
+    bitalign r76, r7, r7, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r7, r7, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r7, r8\n\
+    ibit_extract r75, r7, r1, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r3, r3, l5.yyyy\n\
+    bitalign r76, r3, r3, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r3, r3, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r5, r4, r3\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r6\n\
+    iadd r75, r75, cb0[12].zzzz\n\
+    iadd r76, r75, r11\n\
+    iadd r2, r2, r76\n\
+    iadd r6, r76, r77\n\
+\n\
+    ; blend word 51\n\
+    bitalign r75, r13, r13, l5.zzzz\n\
+    bitalign r76, r13, r13, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r13, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r10, r10, l5.wwww\n\
+    bitalign r75, r10, r10, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r10, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r12\n\
+    iadd r12, r75, r21\n\
+\n\
+    ; step 51\n\
+    bitalign r75, r6, r6, l5.xxxx\n\
+    bitalign r76, r6, r6, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r6, r6, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r6, r7\n\
+    ibit_extract r75, r6, r8, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r2, r2, l5.yyyy\n\
+    bitalign r76, r2, r2, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r2, r2, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r4, r3, r2\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r5\n\
+    iadd r75, r75, cb0[12].wwww\n\
+    iadd r76, r75, r12\n\
+    iadd r1, r1, r76\n\
+    iadd r5, r76, r77\n\
+\n\
+    ; blend word 52\n\
+    bitalign r75, r14, r14, l5.zzzz\n\
+    bitalign r76, r14, r14, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r14, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r11, r11, l5.wwww\n\
+    bitalign r75, r11, r11, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r11, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r13\n\
+    iadd r13, r75, r22\n\
+\n\
+    ; step 52\n\
+    bitalign r75, r5, r5, l5.xxxx\n\
+    bitalign r76, r5, r5, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r5, r5, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r5, r6\n\
+    ibit_extract r75, r5, r7, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r1, r1, l5.yyyy\n\
+    bitalign r76, r1, r1, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r1, r1, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r3, r2, r1\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r4\n\
+    iadd r75, r75, cb0[13].xxxx\n\
+    iadd r76, r75, r13\n\
+    iadd r8, r8, r76\n\
+    iadd r4, r76, r77\n\
+\n\
+    ; blend word 53\n\
+    bitalign r75, r15, r15, l5.zzzz\n\
+    bitalign r76, r15, r15, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r15, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r12, r12, l5.wwww\n\
+    bitalign r75, r12, r12, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r12, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r14\n\
+    iadd r14, r75, r23\n\
+\n\
+    ; step 53\n\
+    bitalign r75, r4, r4, l5.xxxx\n\
+    bitalign r76, r4, r4, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r4, r4, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r4, r5\n\
+    ibit_extract r75, r4, r6, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r8, r8, l5.yyyy\n\
+    bitalign r76, r8, r8, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r8, r8, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r2, r1, r8\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r3\n\
+    iadd r75, r75, cb0[13].yyyy\n\
+    iadd r76, r75, r14\n\
+    iadd r7, r7, r76\n\
+    iadd r3, r76, r77\n\
+\n\
+    ; blend word 54\n\
+    bitalign r75, r16, r16, l5.zzzz\n\
+    bitalign r76, r16, r16, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r16, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r13, r13, l5.wwww\n\
+    bitalign r75, r13, r13, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r13, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r15\n\
+    iadd r15, r75, r24\n\
+\n\
+    ; step 54\n\
+    bitalign r75, r3, r3, l5.xxxx\n\
+    bitalign r76, r3, r3, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r3, r3, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r3, r4\n\
+    ibit_extract r75, r3, r5, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r7, r7, l5.yyyy\n\
+    bitalign r76, r7, r7, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r7, r7, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r1, r8, r7\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r2\n\
+    iadd r75, r75, cb0[13].zzzz\n\
+    iadd r76, r75, r15\n\
+    iadd r6, r6, r76\n\
+    iadd r2, r76, r77\n\
+\n\
+    ; blend word 55\n\
+    bitalign r75, r17, r17, l5.zzzz\n\
+    bitalign r76, r17, r17, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r17, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r14, r14, l5.wwww\n\
+    bitalign r75, r14, r14, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r14, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r16\n\
+    iadd r16, r75, r9\n\
+\n\
+    ; step 55\n\
+    bitalign r75, r2, r2, l5.xxxx\n\
+    bitalign r76, r2, r2, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r2, r2, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r2, r3\n\
+    ibit_extract r75, r2, r4, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r6, r6, l5.yyyy\n\
+    bitalign r76, r6, r6, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r6, r6, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r8, r7, r6\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r1\n\
+    iadd r75, r75, cb0[13].wwww\n\
+    iadd r76, r75, r16\n\
+    iadd r5, r5, r76\n\
+    iadd r1, r76, r77\n\
+\n\
+    ; blend word 56\n\
+    bitalign r75, r18, r18, l5.zzzz\n\
+    bitalign r76, r18, r18, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r18, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r15, r15, l5.wwww\n\
+    bitalign r75, r15, r15, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r15, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r17\n\
+    iadd r17, r75, r10\n\
+\n\
+    ; step 56\n\
+    bitalign r75, r1, r1, l5.xxxx\n\
+    bitalign r76, r1, r1, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r1, r1, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r1, r2\n\
+    ibit_extract r75, r1, r3, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r5, r5, l5.yyyy\n\
+    bitalign r76, r5, r5, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r5, r5, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r7, r6, r5\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r8\n\
+    iadd r75, r75, cb0[14].xxxx\n\
+    iadd r76, r75, r17\n\
+    iadd r4, r4, r76\n\
+    iadd r8, r76, r77\n\
+\n\
+    ; blend word 57\n\
+    bitalign r75, r19, r19, l5.zzzz\n\
+    bitalign r76, r19, r19, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r19, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r16, r16, l5.wwww\n\
+    bitalign r75, r16, r16, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r16, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r18\n\
+    iadd r18, r75, r11\n\
+\n\
+    ; step 57\n\
+    bitalign r75, r8, r8, l5.xxxx\n\
+    bitalign r76, r8, r8, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r8, r8, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r8, r1\n\
+    ibit_extract r75, r8, r2, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r4, r4, l5.yyyy\n\
+    bitalign r76, r4, r4, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r4, r4, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r6, r5, r4\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r7\n\
+    iadd r75, r75, cb0[14].yyyy\n\
+    iadd r76, r75, r18\n\
+    iadd r3, r3, r76\n\
+    iadd r7, r76, r77\n\
+\n\
+    ; blend word 58\n\
+    bitalign r75, r20, r20, l5.zzzz\n\
+    bitalign r76, r20, r20, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r20, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r17, r17, l5.wwww\n\
+    bitalign r75, r17, r17, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r17, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r19\n\
+    iadd r19, r75, r12\n\
+\n\
+    ; step 58\n\
+    bitalign r75, r7, r7, l5.xxxx\n\
+    bitalign r76, r7, r7, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r7, r7, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r7, r8\n\
+    ibit_extract r75, r7, r1, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r3, r3, l5.yyyy\n\
+    bitalign r76, r3, r3, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r3, r3, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r5, r4, r3\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r6\n\
+    iadd r75, r75, cb0[14].zzzz\n\
+    iadd r76, r75, r19\n\
+    iadd r2, r2, r76\n\
+    iadd r6, r76, r77\n\
+\n\
+    ; blend word 59\n\
+    bitalign r75, r21, r21, l5.zzzz\n\
+    bitalign r76, r21, r21, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r21, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r18, r18, l5.wwww\n\
+    bitalign r75, r18, r18, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r18, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r20\n\
+    iadd r20, r75, r13\n\
+\n\
+    ; step 59\n\
+    bitalign r75, r6, r6, l5.xxxx\n\
+    bitalign r76, r6, r6, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r6, r6, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r6, r7\n\
+    ibit_extract r75, r6, r8, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r2, r2, l5.yyyy\n\
+    bitalign r76, r2, r2, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r2, r2, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r4, r3, r2\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r5\n\
+    iadd r75, r75, cb0[14].wwww\n\
+    iadd r76, r75, r20\n\
+    iadd r1, r1, r76\n\
+    iadd r5, r76, r77\n\
+\n\
+    ; blend word 60\n\
+    bitalign r75, r22, r22, l5.zzzz\n\
+    bitalign r76, r22, r22, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r22, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r19, r19, l5.wwww\n\
+    bitalign r75, r19, r19, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r19, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r21\n\
+    iadd r21, r75, r14\n\
+\n\
+    ; step 60\n\
+    bitalign r75, r5, r5, l5.xxxx\n\
+    bitalign r76, r5, r5, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r5, r5, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r5, r6\n\
+    ibit_extract r75, r5, r7, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r1, r1, l5.yyyy\n\
+    bitalign r76, r1, r1, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r1, r1, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r3, r2, r1\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r4\n\
+    iadd r75, r75, cb0[15].xxxx\n\
+    iadd r76, r75, r21\n\
+    iadd r8, r8, r76\n\
+    iadd r4, r76, r77\n\
+\n\
+    ; blend word 61\n\
+    bitalign r75, r23, r23, l5.zzzz\n\
+    bitalign r76, r23, r23, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r23, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r20, r20, l5.wwww\n\
+    bitalign r75, r20, r20, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r20, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r22\n\
+    iadd r22, r75, r15\n\
+\n\
+    ; step 61\n\
+    bitalign r75, r4, r4, l5.xxxx\n\
+    bitalign r76, r4, r4, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r4, r4, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r4, r5\n\
+    ibit_extract r75, r4, r6, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r8, r8, l5.yyyy\n\
+    bitalign r76, r8, r8, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r8, r8, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r2, r1, r8\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r3\n\
+    iadd r75, r75, cb0[15].yyyy\n\
+    iadd r76, r75, r22\n\
+    iadd r7, r7, r76\n\
+    iadd r3, r76, r77\n\
+\n\
+    ; blend word 62\n\
+    bitalign r75, r24, r24, l5.zzzz\n\
+    bitalign r76, r24, r24, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r24, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r21, r21, l5.wwww\n\
+    bitalign r75, r21, r21, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r21, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r23\n\
+    iadd r23, r75, r16\n\
+\n\
+    ; step 62\n\
+    bitalign r75, r3, r3, l5.xxxx\n\
+    bitalign r76, r3, r3, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r3, r3, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r3, r4\n\
+    ibit_extract r75, r3, r5, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r7, r7, l5.yyyy\n\
+    bitalign r76, r7, r7, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r7, r7, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r1, r8, r7\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r2\n\
+    iadd r75, r75, cb0[15].zzzz\n\
+    iadd r76, r75, r23\n\
+    iadd r6, r6, r76\n\
+    iadd r2, r76, r77\n\
+\n\
+    ; blend word 63\n\
+    bitalign r75, r9, r9, l5.zzzz\n\
+    bitalign r76, r9, r9, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r9, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r22, r22, l5.wwww\n\
+    bitalign r75, r22, r22, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r22, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r24\n\
+    iadd r24, r75, r17\n\
+\n\
+    ; step 63\n\
+    bitalign r75, r2, r2, l5.xxxx\n\
+    bitalign r76, r2, r2, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r2, r2, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r2, r3\n\
+    ibit_extract r75, r2, r4, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r6, r6, l5.yyyy\n\
+    bitalign r76, r6, r6, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r6, r6, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r8, r7, r6\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r1\n\
+    iadd r75, r75, cb0[15].wwww\n\
+    iadd r76, r75, r24\n\
+    iadd r5, r5, r76\n\
+    iadd r1, r76, r77\n\
+\n\
+    ; add A,B,C,D,E,F,G,H to intermediate hash values, and store them in\n\
+    ; data words for next SHA-256 hash computation\n\
+    iadd r9, r1, l3.xxxx\n\
+    iadd r10, r2, l3.yyyy\n\
+    iadd r11, r3, l3.zzzz\n\
+    iadd r12, r4, l3.wwww\n\
+    iadd r13, r5, l4.xxxx\n\
+    iadd r14, r6, l4.yyyy\n\
+    iadd r15, r7, l4.zzzz\n\
+    iadd r16, r8, l4.wwww\n\
+    ; the rest of the data words (end-of-message bit, zeros, bit length) are\n\
+    ; literals\n\
+\n\
+    ; init intermediate hash values\n\
+    mov r1, l8.xxxx\n\
+    mov r2, l8.yyyy\n\
+    mov r3, l8.zzzz\n\
+    mov r4, l8.wwww\n\
+    mov r5, l9.xxxx\n\
+    mov r6, l9.yyyy\n\
+    mov r7, l9.zzzz\n\
+    mov r8, l9.wwww\n\
+\n\
+\n\
+    ; step 0\n\
+    bitalign r75, r1, r1, l5.xxxx\n\
+    bitalign r76, r1, r1, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r1, r1, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    iand r75, r1, r2\n\
+    ior r76, r1, r2\n\
+    iand r76, r76, r3\n\
+    ior r75, r75, r76\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r5, r5, l5.yyyy\n\
+    bitalign r76, r5, r5, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r5, r5, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    iand r75, r5, r6\n\
+    inot r76, r5\n\
+    iand r76, r76, r7\n\
+    ior r76, r75, r76\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r8\n\
+    iadd r75, r75, cb0[0].xxxx\n\
+    iadd r76, r75, r9\n\
+    iadd r4, r4, r76\n\
+    iadd r8, r76, r77\n\
+\n\
+    ; step 1\n\
+    bitalign r75, r8, r8, l5.xxxx\n\
+    bitalign r76, r8, r8, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r8, r8, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r8, r1\n\
+    ibit_extract r75, r8, r2, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r4, r4, l5.yyyy\n\
+    bitalign r76, r4, r4, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r4, r4, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r6, r5, r4\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r7\n\
+    iadd r75, r75, cb0[0].yyyy\n\
+    iadd r76, r75, r10\n\
+    iadd r3, r3, r76\n\
+    iadd r7, r76, r77\n\
+\n\
+    ; step 2\n\
+    bitalign r75, r7, r7, l5.xxxx\n\
+    bitalign r76, r7, r7, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r7, r7, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r7, r8\n\
+    ibit_extract r75, r7, r1, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r3, r3, l5.yyyy\n\
+    bitalign r76, r3, r3, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r3, r3, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r5, r4, r3\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r6\n\
+    iadd r75, r75, cb0[0].zzzz\n\
+    iadd r76, r75, r11\n\
+    iadd r2, r2, r76\n\
+    iadd r6, r76, r77\n\
+\n\
+    ; step 3\n\
+    bitalign r75, r6, r6, l5.xxxx\n\
+    bitalign r76, r6, r6, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r6, r6, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r6, r7\n\
+    ibit_extract r75, r6, r8, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r2, r2, l5.yyyy\n\
+    bitalign r76, r2, r2, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r2, r2, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r4, r3, r2\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r5\n\
+    iadd r75, r75, cb0[0].wwww\n\
+    iadd r76, r75, r12\n\
+    iadd r1, r1, r76\n\
+    iadd r5, r76, r77\n\
+\n\
+    ; step 4\n\
+    bitalign r75, r5, r5, l5.xxxx\n\
+    bitalign r76, r5, r5, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r5, r5, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r5, r6\n\
+    ibit_extract r75, r5, r7, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r1, r1, l5.yyyy\n\
+    bitalign r76, r1, r1, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r1, r1, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r3, r2, r1\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r4\n\
+    iadd r75, r75, cb0[1].xxxx\n\
+    iadd r76, r75, r13\n\
+    iadd r8, r8, r76\n\
+    iadd r4, r76, r77\n\
+\n\
+    ; step 5\n\
+    bitalign r75, r4, r4, l5.xxxx\n\
+    bitalign r76, r4, r4, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r4, r4, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r4, r5\n\
+    ibit_extract r75, r4, r6, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r8, r8, l5.yyyy\n\
+    bitalign r76, r8, r8, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r8, r8, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r2, r1, r8\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r3\n\
+    iadd r75, r75, cb0[1].yyyy\n\
+    iadd r76, r75, r14\n\
+    iadd r7, r7, r76\n\
+    iadd r3, r76, r77\n\
+\n\
+    ; step 6\n\
+    bitalign r75, r3, r3, l5.xxxx\n\
+    bitalign r76, r3, r3, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r3, r3, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r3, r4\n\
+    ibit_extract r75, r3, r5, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r7, r7, l5.yyyy\n\
+    bitalign r76, r7, r7, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r7, r7, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r1, r8, r7\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r2\n\
+    iadd r75, r75, cb0[1].zzzz\n\
+    iadd r76, r75, r15\n\
+    iadd r6, r6, r76\n\
+    iadd r2, r76, r77\n\
+\n\
+    ; step 7\n\
+    bitalign r75, r2, r2, l5.xxxx\n\
+    bitalign r76, r2, r2, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r2, r2, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r2, r3\n\
+    ibit_extract r75, r2, r4, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r6, r6, l5.yyyy\n\
+    bitalign r76, r6, r6, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r6, r6, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r8, r7, r6\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r1\n\
+    iadd r75, r75, cb0[1].wwww\n\
+    iadd r76, r75, r16\n\
+    iadd r5, r5, r76\n\
+    iadd r1, r76, r77\n\
+\n\
+    ; step 8\n\
+    bitalign r75, r1, r1, l5.xxxx\n\
+    bitalign r76, r1, r1, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r1, r1, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r1, r2\n\
+    ibit_extract r75, r1, r3, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r5, r5, l5.yyyy\n\
+    bitalign r76, r5, r5, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r5, r5, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r7, r6, r5\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r8\n\
+    iadd r75, r75, cb0[2].xxxx\n\
+    iadd r76, r75, l2.zzzz\n\
+    iadd r4, r4, r76\n\
+    iadd r8, r76, r77\n\
+\n\
+    ; step 9\n\
+    bitalign r75, r8, r8, l5.xxxx\n\
+    bitalign r76, r8, r8, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r8, r8, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r8, r1\n\
+    ibit_extract r75, r8, r2, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r4, r4, l5.yyyy\n\
+    bitalign r76, r4, r4, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r4, r4, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r6, r5, r4\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r7\n\
+    iadd r76, r75, cb0[2].yyyy\n\
+    iadd r3, r3, r76\n\
+    iadd r7, r76, r77\n\
+\n\
+    ; step 10\n\
+    bitalign r75, r7, r7, l5.xxxx\n\
+    bitalign r76, r7, r7, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r7, r7, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r7, r8\n\
+    ibit_extract r75, r7, r1, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r3, r3, l5.yyyy\n\
+    bitalign r76, r3, r3, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r3, r3, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r5, r4, r3\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r6\n\
+    iadd r76, r75, cb0[2].zzzz\n\
+    iadd r2, r2, r76\n\
+    iadd r6, r76, r77\n\
+\n\
+    ; step 11\n\
+    bitalign r75, r6, r6, l5.xxxx\n\
+    bitalign r76, r6, r6, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r6, r6, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r6, r7\n\
+    ibit_extract r75, r6, r8, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r2, r2, l5.yyyy\n\
+    bitalign r76, r2, r2, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r2, r2, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r4, r3, r2\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r5\n\
+    iadd r76, r75, cb0[2].wwww\n\
+    iadd r1, r1, r76\n\
+    iadd r5, r76, r77\n\
+\n\
+    ; step 12\n\
+    bitalign r75, r5, r5, l5.xxxx\n\
+    bitalign r76, r5, r5, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r5, r5, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r5, r6\n\
+    ibit_extract r75, r5, r7, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r1, r1, l5.yyyy\n\
+    bitalign r76, r1, r1, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r1, r1, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r3, r2, r1\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r4\n\
+    iadd r76, r75, cb0[3].xxxx\n\
+    iadd r8, r8, r76\n\
+    iadd r4, r76, r77\n\
+\n\
+    ; step 13\n\
+    bitalign r75, r4, r4, l5.xxxx\n\
+    bitalign r76, r4, r4, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r4, r4, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r4, r5\n\
+    ibit_extract r75, r4, r6, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r8, r8, l5.yyyy\n\
+    bitalign r76, r8, r8, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r8, r8, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r2, r1, r8\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r3\n\
+    iadd r76, r75, cb0[3].yyyy\n\
+    iadd r7, r7, r76\n\
+    iadd r3, r76, r77\n\
+\n\
+    ; step 14\n\
+    bitalign r75, r3, r3, l5.xxxx\n\
+    bitalign r76, r3, r3, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r3, r3, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r3, r4\n\
+    ibit_extract r75, r3, r5, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r7, r7, l5.yyyy\n\
+    bitalign r76, r7, r7, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r7, r7, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r1, r8, r7\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r2\n\
+    iadd r76, r75, cb0[3].zzzz\n\
+    iadd r6, r6, r76\n\
+    iadd r2, r76, r77\n\
+\n\
+    ; step 15\n\
+    bitalign r75, r2, r2, l5.xxxx\n\
+    bitalign r76, r2, r2, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r2, r2, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r2, r3\n\
+    ibit_extract r75, r2, r4, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r6, r6, l5.yyyy\n\
+    bitalign r76, r6, r6, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r6, r6, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r8, r7, r6\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r1\n\
+    iadd r75, r75, cb0[3].wwww\n\
+    iadd r76, r75, l1.zzzz\n\
+    iadd r5, r5, r76\n\
+    iadd r1, r76, r77\n\
+\n\
+    ; blend word 16\n\
+    bitalign r75, r10, r10, l5.zzzz\n\
+    bitalign r76, r10, r10, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r10, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    iadd r9, r77, r9\n\
+\n\
+    ; step 16\n\
+    bitalign r75, r1, r1, l5.xxxx\n\
+    bitalign r76, r1, r1, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r1, r1, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r1, r2\n\
+    ibit_extract r75, r1, r3, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r5, r5, l5.yyyy\n\
+    bitalign r76, r5, r5, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r5, r5, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r7, r6, r5\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r8\n\
+    iadd r75, r75, cb0[4].xxxx\n\
+    iadd r76, r75, r9\n\
+    iadd r4, r4, r76\n\
+    iadd r8, r76, r77\n\
+\n\
+    ; blend word 17\n\
+    bitalign r75, r11, r11, l5.zzzz\n\
+    bitalign r76, r11, r11, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r11, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    iadd r75, r77, r10\n\
+    iadd r10, r75, l2.xxxx\n\
+\n\
+    ; step 17\n\
+    bitalign r75, r8, r8, l5.xxxx\n\
+    bitalign r76, r8, r8, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r8, r8, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r8, r1\n\
+    ibit_extract r75, r8, r2, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r4, r4, l5.yyyy\n\
+    bitalign r76, r4, r4, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r4, r4, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r6, r5, r4\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r7\n\
+    iadd r75, r75, cb0[4].yyyy\n\
+    iadd r76, r75, r10\n\
+    iadd r3, r3, r76\n\
+    iadd r7, r76, r77\n\
+\n\
+    ; blend word 18\n\
+    bitalign r75, r12, r12, l5.zzzz\n\
+    bitalign r76, r12, r12, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r12, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r9, r9, l5.wwww\n\
+    bitalign r75, r9, r9, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r9, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r11, r75, r11\n\
+\n\
+    ; step 18\n\
+    bitalign r75, r7, r7, l5.xxxx\n\
+    bitalign r76, r7, r7, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r7, r7, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r7, r8\n\
+    ibit_extract r75, r7, r1, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r3, r3, l5.yyyy\n\
+    bitalign r76, r3, r3, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r3, r3, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r5, r4, r3\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r6\n\
+    iadd r75, r75, cb0[4].zzzz\n\
+    iadd r76, r75, r11\n\
+    iadd r2, r2, r76\n\
+    iadd r6, r76, r77\n\
+\n\
+    ; blend word 19\n\
+    bitalign r75, r13, r13, l5.zzzz\n\
+    bitalign r76, r13, r13, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r13, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r10, r10, l5.wwww\n\
+    bitalign r75, r10, r10, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r10, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r12, r75, r12\n\
+\n\
+    ; step 19\n\
+    bitalign r75, r6, r6, l5.xxxx\n\
+    bitalign r76, r6, r6, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r6, r6, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r6, r7\n\
+    ibit_extract r75, r6, r8, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r2, r2, l5.yyyy\n\
+    bitalign r76, r2, r2, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r2, r2, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r4, r3, r2\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r5\n\
+    iadd r75, r75, cb0[4].wwww\n\
+    iadd r76, r75, r12\n\
+    iadd r1, r1, r76\n\
+    iadd r5, r76, r77\n\
+\n\
+    ; blend word 20\n\
+    bitalign r75, r14, r14, l5.zzzz\n\
+    bitalign r76, r14, r14, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r14, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r11, r11, l5.wwww\n\
+    bitalign r75, r11, r11, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r11, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r13, r75, r13\n\
+\n\
+    ; step 20\n\
+    bitalign r75, r5, r5, l5.xxxx\n\
+    bitalign r76, r5, r5, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r5, r5, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r5, r6\n\
+    ibit_extract r75, r5, r7, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r1, r1, l5.yyyy\n\
+    bitalign r76, r1, r1, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r1, r1, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r3, r2, r1\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r4\n\
+    iadd r75, r75, cb0[5].xxxx\n\
+    iadd r76, r75, r13\n\
+    iadd r8, r8, r76\n\
+    iadd r4, r76, r77\n\
+\n\
+    ; blend word 21\n\
+    bitalign r75, r15, r15, l5.zzzz\n\
+    bitalign r76, r15, r15, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r15, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r12, r12, l5.wwww\n\
+    bitalign r75, r12, r12, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r12, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r14, r75, r14\n\
+\n\
+    ; step 21\n\
+    bitalign r75, r4, r4, l5.xxxx\n\
+    bitalign r76, r4, r4, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r4, r4, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r4, r5\n\
+    ibit_extract r75, r4, r6, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r8, r8, l5.yyyy\n\
+    bitalign r76, r8, r8, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r8, r8, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r2, r1, r8\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r3\n\
+    iadd r75, r75, cb0[5].yyyy\n\
+    iadd r76, r75, r14\n\
+    iadd r7, r7, r76\n\
+    iadd r3, r76, r77\n\
+\n\
+    ; blend word 22\n\
+    bitalign r75, r16, r16, l5.zzzz\n\
+    bitalign r76, r16, r16, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r16, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r13, r13, l5.wwww\n\
+    bitalign r75, r13, r13, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r13, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r15, r75, r15\n\
+    iadd r15, r15, l1.zzzz\n\
+\n\
+    ; step 22\n\
+    bitalign r75, r3, r3, l5.xxxx\n\
+    bitalign r76, r3, r3, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r3, r3, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r3, r4\n\
+    ibit_extract r75, r3, r5, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r7, r7, l5.yyyy\n\
+    bitalign r76, r7, r7, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r7, r7, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r1, r8, r7\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r2\n\
+    iadd r75, r75, cb0[5].zzzz\n\
+    iadd r76, r75, r15\n\
+    iadd r6, r6, r76\n\
+    iadd r2, r76, r77\n\
+\n\
+    ; blend word 23\n\
+    bitalign r76, r14, r14, l5.wwww\n\
+    bitalign r75, r14, r14, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r14, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r76, r9\n\
+    iadd r75, r75, r16\n\
+    iadd r16, r75, l2.yyyy\n\
+\n\
+    ; step 23\n\
+    bitalign r75, r2, r2, l5.xxxx\n\
+    bitalign r76, r2, r2, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r2, r2, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r2, r3\n\
+    ibit_extract r75, r2, r4, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r6, r6, l5.yyyy\n\
+    bitalign r76, r6, r6, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r6, r6, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r8, r7, r6\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r1\n\
+    iadd r75, r75, cb0[5].wwww\n\
+    iadd r76, r75, r16\n\
+    iadd r5, r5, r76\n\
+    iadd r1, r76, r77\n\
+\n\
+    ; blend word 24\n\
+    bitalign r76, r15, r15, l5.wwww\n\
+    bitalign r75, r15, r15, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r15, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r76, r10\n\
+    iadd r17, r75, l2.zzzz\n\
+\n\
+    ; step 24\n\
+    bitalign r75, r1, r1, l5.xxxx\n\
+    bitalign r76, r1, r1, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r1, r1, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r1, r2\n\
+    ibit_extract r75, r1, r3, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r5, r5, l5.yyyy\n\
+    bitalign r76, r5, r5, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r5, r5, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r7, r6, r5\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r8\n\
+    iadd r75, r75, cb0[6].xxxx\n\
+    iadd r76, r75, r17\n\
+    iadd r4, r4, r76\n\
+    iadd r8, r76, r77\n\
+\n\
+    ; blend word 25\n\
+    bitalign r76, r16, r16, l5.wwww\n\
+    bitalign r75, r16, r16, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r16, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r18, r76, r11\n\
+\n\
+    ; step 25\n\
+    bitalign r75, r8, r8, l5.xxxx\n\
+    bitalign r76, r8, r8, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r8, r8, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r8, r1\n\
+    ibit_extract r75, r8, r2, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r4, r4, l5.yyyy\n\
+    bitalign r76, r4, r4, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r4, r4, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r6, r5, r4\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r7\n\
+    iadd r75, r75, cb0[6].yyyy\n\
+    iadd r76, r75, r18\n\
+    iadd r3, r3, r76\n\
+    iadd r7, r76, r77\n\
+\n\
+    ; blend word 26\n\
+    bitalign r76, r17, r17, l5.wwww\n\
+    bitalign r75, r17, r17, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r17, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r19, r76, r12\n\
+\n\
+    ; step 26\n\
+    bitalign r75, r7, r7, l5.xxxx\n\
+    bitalign r76, r7, r7, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r7, r7, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r7, r8\n\
+    ibit_extract r75, r7, r1, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r3, r3, l5.yyyy\n\
+    bitalign r76, r3, r3, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r3, r3, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r5, r4, r3\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r6\n\
+    iadd r75, r75, cb0[6].zzzz\n\
+    iadd r76, r75, r19\n\
+    iadd r2, r2, r76\n\
+    iadd r6, r76, r77\n\
+\n\
+    ; blend word 27\n\
+    bitalign r76, r18, r18, l5.wwww\n\
+    bitalign r75, r18, r18, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r18, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r20, r76, r13\n\
+\n\
+    ; step 27\n\
+    bitalign r75, r6, r6, l5.xxxx\n\
+    bitalign r76, r6, r6, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r6, r6, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r6, r7\n\
+    ibit_extract r75, r6, r8, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r2, r2, l5.yyyy\n\
+    bitalign r76, r2, r2, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r2, r2, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r4, r3, r2\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r5\n\
+    iadd r75, r75, cb0[6].wwww\n\
+    iadd r76, r75, r20\n\
+    iadd r1, r1, r76\n\
+    iadd r5, r76, r77\n\
+\n\
+    ; blend word 28\n\
+    bitalign r76, r19, r19, l5.wwww\n\
+    bitalign r75, r19, r19, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r19, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r21, r76, r14\n\
+\n\
+    ; step 28\n\
+    bitalign r75, r5, r5, l5.xxxx\n\
+    bitalign r76, r5, r5, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r5, r5, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r5, r6\n\
+    ibit_extract r75, r5, r7, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r1, r1, l5.yyyy\n\
+    bitalign r76, r1, r1, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r1, r1, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r3, r2, r1\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r4\n\
+    iadd r75, r75, cb0[7].xxxx\n\
+    iadd r76, r75, r21\n\
+    iadd r8, r8, r76\n\
+    iadd r4, r76, r77\n\
+\n\
+    ; blend word 29\n\
+    bitalign r76, r20, r20, l5.wwww\n\
+    bitalign r75, r20, r20, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r20, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r22, r76, r15\n\
+\n\
+    ; step 29\n\
+    bitalign r75, r4, r4, l5.xxxx\n\
+    bitalign r76, r4, r4, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r4, r4, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r4, r5\n\
+    ibit_extract r75, r4, r6, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r8, r8, l5.yyyy\n\
+    bitalign r76, r8, r8, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r8, r8, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r2, r1, r8\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r3\n\
+    iadd r75, r75, cb0[7].yyyy\n\
+    iadd r76, r75, r22\n\
+    iadd r7, r7, r76\n\
+    iadd r3, r76, r77\n\
+\n\
+    ; blend word 30\n\
+    bitalign r76, r21, r21, l5.wwww\n\
+    bitalign r75, r21, r21, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r21, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r76, r16\n\
+    iadd r23, r75, l1.wwww\n\
+\n\
+    ; step 30\n\
+    bitalign r75, r3, r3, l5.xxxx\n\
+    bitalign r76, r3, r3, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r3, r3, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r3, r4\n\
+    ibit_extract r75, r3, r5, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r7, r7, l5.yyyy\n\
+    bitalign r76, r7, r7, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r7, r7, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r1, r8, r7\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r2\n\
+    iadd r75, r75, cb0[7].zzzz\n\
+    iadd r76, r75, r23\n\
+    iadd r6, r6, r76\n\
+    iadd r2, r76, r77\n\
+\n\
+    ; blend word 31\n\
+    bitalign r75, r9, r9, l5.zzzz\n\
+    bitalign r76, r9, r9, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r9, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r22, r22, l5.wwww\n\
+    bitalign r75, r22, r22, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r22, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r17\n\
+    iadd r24, r75, l1.zzzz\n\
+\n\
+    ; step 31\n\
+    bitalign r75, r2, r2, l5.xxxx\n\
+    bitalign r76, r2, r2, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r2, r2, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r2, r3\n\
+    ibit_extract r75, r2, r4, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r6, r6, l5.yyyy\n\
+    bitalign r76, r6, r6, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r6, r6, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r8, r7, r6\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r1\n\
+    iadd r75, r75, cb0[7].wwww\n\
+    iadd r76, r75, r24\n\
+    iadd r5, r5, r76\n\
+    iadd r1, r76, r77\n\
+\n\
+    ; blend word 32\n\
+    bitalign r75, r10, r10, l5.zzzz\n\
+    bitalign r76, r10, r10, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r10, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r23, r23, l5.wwww\n\
+    bitalign r75, r23, r23, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r23, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r9\n\
+    iadd r9, r75, r18\n\
+\n\
+    ; step 32\n\
+    bitalign r75, r1, r1, l5.xxxx\n\
+    bitalign r76, r1, r1, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r1, r1, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r1, r2\n\
+    ibit_extract r75, r1, r3, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r5, r5, l5.yyyy\n\
+    bitalign r76, r5, r5, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r5, r5, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r7, r6, r5\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r8\n\
+    iadd r75, r75, cb0[8].xxxx\n\
+    iadd r76, r75, r9\n\
+    iadd r4, r4, r76\n\
+    iadd r8, r76, r77\n\
+\n\
+    ; blend word 33\n\
+    bitalign r75, r11, r11, l5.zzzz\n\
+    bitalign r76, r11, r11, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r11, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r24, r24, l5.wwww\n\
+    bitalign r75, r24, r24, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r24, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r10\n\
+    iadd r10, r75, r19\n\
+\n\
+    ; step 33\n\
+    bitalign r75, r8, r8, l5.xxxx\n\
+    bitalign r76, r8, r8, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r8, r8, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r8, r1\n\
+    ibit_extract r75, r8, r2, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r4, r4, l5.yyyy\n\
+    bitalign r76, r4, r4, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r4, r4, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r6, r5, r4\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r7\n\
+    iadd r75, r75, cb0[8].yyyy\n\
+    iadd r76, r75, r10\n\
+    iadd r3, r3, r76\n\
+    iadd r7, r76, r77\n\
+\n\
+    ; blend word 34\n\
+    bitalign r75, r12, r12, l5.zzzz\n\
+    bitalign r76, r12, r12, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r12, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r9, r9, l5.wwww\n\
+    bitalign r75, r9, r9, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r9, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r11\n\
+    iadd r11, r75, r20\n\
+\n\
+    ; step 34\n\
+    bitalign r75, r7, r7, l5.xxxx\n\
+    bitalign r76, r7, r7, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r7, r7, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r7, r8\n\
+    ibit_extract r75, r7, r1, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r3, r3, l5.yyyy\n\
+    bitalign r76, r3, r3, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r3, r3, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r5, r4, r3\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r6\n\
+    iadd r75, r75, cb0[8].zzzz\n\
+    iadd r76, r75, r11\n\
+    iadd r2, r2, r76\n\
+    iadd r6, r76, r77\n\
+\n\
+    ; blend word 35\n\
+    bitalign r75, r13, r13, l5.zzzz\n\
+    bitalign r76, r13, r13, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r13, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r10, r10, l5.wwww\n\
+    bitalign r75, r10, r10, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r10, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r12\n\
+    iadd r12, r75, r21\n\
+\n\
+    ; step 35\n\
+    bitalign r75, r6, r6, l5.xxxx\n\
+    bitalign r76, r6, r6, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r6, r6, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r6, r7\n\
+    ibit_extract r75, r6, r8, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r2, r2, l5.yyyy\n\
+    bitalign r76, r2, r2, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r2, r2, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r4, r3, r2\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r5\n\
+    iadd r75, r75, cb0[8].wwww\n\
+    iadd r76, r75, r12\n\
+    iadd r1, r1, r76\n\
+    iadd r5, r76, r77\n\
+\n\
+    ; blend word 36\n\
+    bitalign r75, r14, r14, l5.zzzz\n\
+    bitalign r76, r14, r14, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r14, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r11, r11, l5.wwww\n\
+    bitalign r75, r11, r11, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r11, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r13\n\
+    iadd r13, r75, r22\n\
+\n\
+    ; step 36\n\
+    bitalign r75, r5, r5, l5.xxxx\n\
+    bitalign r76, r5, r5, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r5, r5, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r5, r6\n\
+    ibit_extract r75, r5, r7, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r1, r1, l5.yyyy\n\
+    bitalign r76, r1, r1, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r1, r1, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r3, r2, r1\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r4\n\
+    iadd r75, r75, cb0[9].xxxx\n\
+    iadd r76, r75, r13\n\
+    iadd r8, r8, r76\n\
+    iadd r4, r76, r77\n\
+\n\
+    ; blend word 37\n\
+    bitalign r75, r15, r15, l5.zzzz\n\
+    bitalign r76, r15, r15, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r15, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r12, r12, l5.wwww\n\
+    bitalign r75, r12, r12, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r12, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r14\n\
+    iadd r14, r75, r23\n\
+\n\
+    ; step 37\n\
+    bitalign r75, r4, r4, l5.xxxx\n\
+    bitalign r76, r4, r4, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r4, r4, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r4, r5\n\
+    ibit_extract r75, r4, r6, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r8, r8, l5.yyyy\n\
+    bitalign r76, r8, r8, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r8, r8, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r2, r1, r8\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r3\n\
+    iadd r75, r75, cb0[9].yyyy\n\
+    iadd r76, r75, r14\n\
+    iadd r7, r7, r76\n\
+    iadd r3, r76, r77\n\
+\n\
+    ; blend word 38\n\
+    bitalign r75, r16, r16, l5.zzzz\n\
+    bitalign r76, r16, r16, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r16, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r13, r13, l5.wwww\n\
+    bitalign r75, r13, r13, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r13, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r15\n\
+    iadd r15, r75, r24\n\
+\n\
+    ; step 38\n\
+    bitalign r75, r3, r3, l5.xxxx\n\
+    bitalign r76, r3, r3, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r3, r3, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r3, r4\n\
+    ibit_extract r75, r3, r5, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r7, r7, l5.yyyy\n\
+    bitalign r76, r7, r7, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r7, r7, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r1, r8, r7\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r2\n\
+    iadd r75, r75, cb0[9].zzzz\n\
+    iadd r76, r75, r15\n\
+    iadd r6, r6, r76\n\
+    iadd r2, r76, r77\n\
+\n\
+    ; blend word 39\n\
+    bitalign r75, r17, r17, l5.zzzz\n\
+    bitalign r76, r17, r17, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r17, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r14, r14, l5.wwww\n\
+    bitalign r75, r14, r14, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r14, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r16\n\
+    iadd r16, r75, r9\n\
+\n\
+    ; step 39\n\
+    bitalign r75, r2, r2, l5.xxxx\n\
+    bitalign r76, r2, r2, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r2, r2, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r2, r3\n\
+    ibit_extract r75, r2, r4, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r6, r6, l5.yyyy\n\
+    bitalign r76, r6, r6, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r6, r6, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r8, r7, r6\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r1\n\
+    iadd r75, r75, cb0[9].wwww\n\
+    iadd r76, r75, r16\n\
+    iadd r5, r5, r76\n\
+    iadd r1, r76, r77\n\
+\n\
+    ; blend word 40\n\
+    bitalign r75, r18, r18, l5.zzzz\n\
+    bitalign r76, r18, r18, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r18, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r15, r15, l5.wwww\n\
+    bitalign r75, r15, r15, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r15, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r17\n\
+    iadd r17, r75, r10\n\
+\n\
+    ; step 40\n\
+    bitalign r75, r1, r1, l5.xxxx\n\
+    bitalign r76, r1, r1, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r1, r1, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r1, r2\n\
+    ibit_extract r75, r1, r3, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r5, r5, l5.yyyy\n\
+    bitalign r76, r5, r5, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r5, r5, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r7, r6, r5\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r8\n\
+    iadd r75, r75, cb0[10].xxxx\n\
+    iadd r76, r75, r17\n\
+    iadd r4, r4, r76\n\
+    iadd r8, r76, r77\n\
+\n\
+    ; blend word 41\n\
+    bitalign r75, r19, r19, l5.zzzz\n\
+    bitalign r76, r19, r19, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r19, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r16, r16, l5.wwww\n\
+    bitalign r75, r16, r16, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r16, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r18\n\
+    iadd r18, r75, r11\n\
+\n\
+    ; step 41\n\
+    bitalign r75, r8, r8, l5.xxxx\n\
+    bitalign r76, r8, r8, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r8, r8, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r8, r1\n\
+    ibit_extract r75, r8, r2, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r4, r4, l5.yyyy\n\
+    bitalign r76, r4, r4, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r4, r4, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r6, r5, r4\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r7\n\
+    iadd r75, r75, cb0[10].yyyy\n\
+    iadd r76, r75, r18\n\
+    iadd r3, r3, r76\n\
+    iadd r7, r76, r77\n\
+\n\
+    ; blend word 42\n\
+    bitalign r75, r20, r20, l5.zzzz\n\
+    bitalign r76, r20, r20, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r20, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r17, r17, l5.wwww\n\
+    bitalign r75, r17, r17, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r17, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r19\n\
+    iadd r19, r75, r12\n\
+\n\
+    ; step 42\n\
+    bitalign r75, r7, r7, l5.xxxx\n\
+    bitalign r76, r7, r7, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r7, r7, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r7, r8\n\
+    ibit_extract r75, r7, r1, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r3, r3, l5.yyyy\n\
+    bitalign r76, r3, r3, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r3, r3, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r5, r4, r3\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r6\n\
+    iadd r75, r75, cb0[10].zzzz\n\
+    iadd r76, r75, r19\n\
+    iadd r2, r2, r76\n\
+    iadd r6, r76, r77\n\
+\n\
+    ; blend word 43\n\
+    bitalign r75, r21, r21, l5.zzzz\n\
+    bitalign r76, r21, r21, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r21, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r18, r18, l5.wwww\n\
+    bitalign r75, r18, r18, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r18, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r20\n\
+    iadd r20, r75, r13\n\
+\n\
+    ; step 43\n\
+    bitalign r75, r6, r6, l5.xxxx\n\
+    bitalign r76, r6, r6, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r6, r6, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r6, r7\n\
+    ibit_extract r75, r6, r8, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r2, r2, l5.yyyy\n\
+    bitalign r76, r2, r2, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r2, r2, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r4, r3, r2\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r5\n\
+    iadd r75, r75, cb0[10].wwww\n\
+    iadd r76, r75, r20\n\
+    iadd r1, r1, r76\n\
+    iadd r5, r76, r77\n\
+\n\
+    ; blend word 44\n\
+    bitalign r75, r22, r22, l5.zzzz\n\
+    bitalign r76, r22, r22, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r22, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r19, r19, l5.wwww\n\
+    bitalign r75, r19, r19, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r19, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r21\n\
+    iadd r21, r75, r14\n\
+\n\
+    ; step 44\n\
+    bitalign r75, r5, r5, l5.xxxx\n\
+    bitalign r76, r5, r5, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r5, r5, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r5, r6\n\
+    ibit_extract r75, r5, r7, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r1, r1, l5.yyyy\n\
+    bitalign r76, r1, r1, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r1, r1, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r3, r2, r1\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r4\n\
+    iadd r75, r75, cb0[11].xxxx\n\
+    iadd r76, r75, r21\n\
+    iadd r8, r8, r76\n\
+    iadd r4, r76, r77\n\
+\n\
+    ; blend word 45\n\
+    bitalign r75, r23, r23, l5.zzzz\n\
+    bitalign r76, r23, r23, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r23, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r20, r20, l5.wwww\n\
+    bitalign r75, r20, r20, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r20, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r22\n\
+    iadd r22, r75, r15\n\
+\n\
+    ; step 45\n\
+    bitalign r75, r4, r4, l5.xxxx\n\
+    bitalign r76, r4, r4, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r4, r4, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r4, r5\n\
+    ibit_extract r75, r4, r6, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r8, r8, l5.yyyy\n\
+    bitalign r76, r8, r8, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r8, r8, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r2, r1, r8\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r3\n\
+    iadd r75, r75, cb0[11].yyyy\n\
+    iadd r76, r75, r22\n\
+    iadd r7, r7, r76\n\
+    iadd r3, r76, r77\n\
+\n\
+    ; blend word 46\n\
+    bitalign r75, r24, r24, l5.zzzz\n\
+    bitalign r76, r24, r24, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r24, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r21, r21, l5.wwww\n\
+    bitalign r75, r21, r21, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r21, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r23\n\
+    iadd r23, r75, r16\n\
+\n\
+    ; step 46\n\
+    bitalign r75, r3, r3, l5.xxxx\n\
+    bitalign r76, r3, r3, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r3, r3, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r3, r4\n\
+    ibit_extract r75, r3, r5, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r7, r7, l5.yyyy\n\
+    bitalign r76, r7, r7, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r7, r7, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r1, r8, r7\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r2\n\
+    iadd r75, r75, cb0[11].zzzz\n\
+    iadd r76, r75, r23\n\
+    iadd r6, r6, r76\n\
+    iadd r2, r76, r77\n\
+\n\
+    ; blend word 47\n\
+    bitalign r75, r9, r9, l5.zzzz\n\
+    bitalign r76, r9, r9, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r9, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r22, r22, l5.wwww\n\
+    bitalign r75, r22, r22, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r22, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r24\n\
+    iadd r24, r75, r17\n\
+\n\
+    ; step 47\n\
+    bitalign r75, r2, r2, l5.xxxx\n\
+    bitalign r76, r2, r2, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r2, r2, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r2, r3\n\
+    ibit_extract r75, r2, r4, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r6, r6, l5.yyyy\n\
+    bitalign r76, r6, r6, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r6, r6, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r8, r7, r6\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r1\n\
+    iadd r75, r75, cb0[11].wwww\n\
+    iadd r76, r75, r24\n\
+    iadd r5, r5, r76\n\
+    iadd r1, r76, r77\n\
+\n\
+    ; blend word 48\n\
+    bitalign r75, r10, r10, l5.zzzz\n\
+    bitalign r76, r10, r10, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r10, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r23, r23, l5.wwww\n\
+    bitalign r75, r23, r23, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r23, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r9\n\
+    iadd r9, r75, r18\n\
+\n\
+    ; step 48\n\
+    bitalign r75, r1, r1, l5.xxxx\n\
+    bitalign r76, r1, r1, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r1, r1, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r1, r2\n\
+    ibit_extract r75, r1, r3, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r5, r5, l5.yyyy\n\
+    bitalign r76, r5, r5, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r5, r5, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r7, r6, r5\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r8\n\
+    iadd r75, r75, cb0[12].xxxx\n\
+    iadd r76, r75, r9\n\
+    iadd r4, r4, r76\n\
+    iadd r8, r76, r77\n\
+\n\
+    ; blend word 49\n\
+    bitalign r75, r11, r11, l5.zzzz\n\
+    bitalign r76, r11, r11, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r11, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r24, r24, l5.wwww\n\
+    bitalign r75, r24, r24, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r24, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r10\n\
+    iadd r10, r75, r19\n\
+\n\
+    ; step 49\n\
+    bitalign r75, r8, r8, l5.xxxx\n\
+    bitalign r76, r8, r8, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r8, r8, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r8, r1\n\
+    ibit_extract r75, r8, r2, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r4, r4, l5.yyyy\n\
+    bitalign r76, r4, r4, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r4, r4, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r6, r5, r4\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r7\n\
+    iadd r75, r75, cb0[12].yyyy\n\
+    iadd r76, r75, r10\n\
+    iadd r3, r3, r76\n\
+    iadd r7, r76, r77\n\
+\n\
+    ; blend word 50\n\
+    bitalign r75, r12, r12, l5.zzzz\n\
+    bitalign r76, r12, r12, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r12, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r9, r9, l5.wwww\n\
+    bitalign r75, r9, r9, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r9, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r11\n\
+    iadd r11, r75, r20\n\
+\n\
+    ; step 50\n\
+    bitalign r75, r7, r7, l5.xxxx\n\
+    bitalign r76, r7, r7, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r7, r7, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r7, r8\n\
+    ibit_extract r75, r7, r1, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r3, r3, l5.yyyy\n\
+    bitalign r76, r3, r3, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r3, r3, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r5, r4, r3\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r6\n\
+    iadd r75, r75, cb0[12].zzzz\n\
+    iadd r76, r75, r11\n\
+    iadd r2, r2, r76\n\
+    iadd r6, r76, r77\n\
+\n\
+    ; blend word 51\n\
+    bitalign r75, r13, r13, l5.zzzz\n\
+    bitalign r76, r13, r13, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r13, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r10, r10, l5.wwww\n\
+    bitalign r75, r10, r10, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r10, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r12\n\
+    iadd r12, r75, r21\n\
+\n\
+    ; step 51\n\
+    bitalign r75, r6, r6, l5.xxxx\n\
+    bitalign r76, r6, r6, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r6, r6, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r6, r7\n\
+    ibit_extract r75, r6, r8, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r2, r2, l5.yyyy\n\
+    bitalign r76, r2, r2, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r2, r2, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r4, r3, r2\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r5\n\
+    iadd r75, r75, cb0[12].wwww\n\
+    iadd r76, r75, r12\n\
+    iadd r1, r1, r76\n\
+    iadd r5, r76, r77\n\
+\n\
+    ; blend word 52\n\
+    bitalign r75, r14, r14, l5.zzzz\n\
+    bitalign r76, r14, r14, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r14, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r11, r11, l5.wwww\n\
+    bitalign r75, r11, r11, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r11, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r13\n\
+    iadd r13, r75, r22\n\
+\n\
+    ; step 52\n\
+    bitalign r75, r5, r5, l5.xxxx\n\
+    bitalign r76, r5, r5, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r5, r5, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r5, r6\n\
+    ibit_extract r75, r5, r7, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r1, r1, l5.yyyy\n\
+    bitalign r76, r1, r1, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r1, r1, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r3, r2, r1\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r4\n\
+    iadd r75, r75, cb0[13].xxxx\n\
+    iadd r76, r75, r13\n\
+    iadd r8, r8, r76\n\
+    iadd r4, r76, r77\n\
+\n\
+    ; blend word 53\n\
+    bitalign r75, r15, r15, l5.zzzz\n\
+    bitalign r76, r15, r15, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r15, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r12, r12, l5.wwww\n\
+    bitalign r75, r12, r12, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r12, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r14\n\
+    iadd r14, r75, r23\n\
+\n\
+    ; step 53\n\
+    bitalign r75, r4, r4, l5.xxxx\n\
+    bitalign r76, r4, r4, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r4, r4, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r4, r5\n\
+    ibit_extract r75, r4, r6, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r8, r8, l5.yyyy\n\
+    bitalign r76, r8, r8, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r8, r8, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r2, r1, r8\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r3\n\
+    iadd r75, r75, cb0[13].yyyy\n\
+    iadd r76, r75, r14\n\
+    iadd r7, r7, r76\n\
+    iadd r3, r76, r77\n\
+\n\
+    ; blend word 54\n\
+    bitalign r75, r16, r16, l5.zzzz\n\
+    bitalign r76, r16, r16, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r16, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r13, r13, l5.wwww\n\
+    bitalign r75, r13, r13, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r13, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r15\n\
+    iadd r15, r75, r24\n\
+\n\
+    ; step 54\n\
+    bitalign r75, r3, r3, l5.xxxx\n\
+    bitalign r76, r3, r3, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r3, r3, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r3, r4\n\
+    ibit_extract r75, r3, r5, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r7, r7, l5.yyyy\n\
+    bitalign r76, r7, r7, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r7, r7, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r1, r8, r7\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r2\n\
+    iadd r75, r75, cb0[13].zzzz\n\
+    iadd r76, r75, r15\n\
+    iadd r6, r6, r76\n\
+    iadd r2, r76, r77\n\
+\n\
+    ; blend word 55\n\
+    bitalign r75, r17, r17, l5.zzzz\n\
+    bitalign r76, r17, r17, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r17, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r14, r14, l5.wwww\n\
+    bitalign r75, r14, r14, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r14, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r16\n\
+    iadd r16, r75, r9\n\
+\n\
+    ; step 55\n\
+    bitalign r75, r2, r2, l5.xxxx\n\
+    bitalign r76, r2, r2, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r2, r2, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r2, r3\n\
+    ibit_extract r75, r2, r4, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r6, r6, l5.yyyy\n\
+    bitalign r76, r6, r6, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r6, r6, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r8, r7, r6\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r1\n\
+    iadd r75, r75, cb0[13].wwww\n\
+    iadd r76, r75, r16\n\
+    iadd r5, r5, r76\n\
+    iadd r1, r76, r77\n\
+\n\
+    ; blend word 56\n\
+    bitalign r75, r18, r18, l5.zzzz\n\
+    bitalign r76, r18, r18, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r18, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r15, r15, l5.wwww\n\
+    bitalign r75, r15, r15, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r15, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r17\n\
+    iadd r17, r75, r10\n\
+\n\
+    ; step 56\n\
+    bitalign r75, r1, r1, l5.xxxx\n\
+    bitalign r76, r1, r1, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r1, r1, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r1, r2\n\
+    ibit_extract r75, r1, r3, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r5, r5, l5.yyyy\n\
+    bitalign r76, r5, r5, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r5, r5, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r7, r6, r5\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r8\n\
+    iadd r75, r75, cb0[14].xxxx\n\
+    iadd r76, r75, r17\n\
+    iadd r4, r4, r76\n\
+    iadd r8, r76, r77\n\
+\n\
+    ; blend word 57\n\
+    bitalign r75, r19, r19, l5.zzzz\n\
+    bitalign r76, r19, r19, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r19, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r16, r16, l5.wwww\n\
+    bitalign r75, r16, r16, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r16, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r18\n\
+    iadd r18, r75, r11\n\
+\n\
+    ; step 57\n\
+    bitalign r75, r8, r8, l5.xxxx\n\
+    bitalign r76, r8, r8, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r8, r8, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r8, r1\n\
+    ibit_extract r75, r8, r2, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r4, r4, l5.yyyy\n\
+    bitalign r76, r4, r4, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r4, r4, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r6, r5, r4\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r7\n\
+    iadd r75, r75, cb0[14].yyyy\n\
+    iadd r76, r75, r18\n\
+    iadd r3, r3, r76\n\
+    iadd r7, r76, r77\n\
+\n\
+    ; blend word 58\n\
+    bitalign r75, r20, r20, l5.zzzz\n\
+    bitalign r76, r20, r20, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r20, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r17, r17, l5.wwww\n\
+    bitalign r75, r17, r17, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r17, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r19\n\
+    iadd r19, r75, r12\n\
+\n\
+    ; step 58\n\
+    bitalign r75, r7, r7, l5.xxxx\n\
+    bitalign r76, r7, r7, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r7, r7, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r7, r8\n\
+    ibit_extract r75, r7, r1, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r3, r3, l5.yyyy\n\
+    bitalign r76, r3, r3, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r3, r3, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r5, r4, r3\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r6\n\
+    iadd r75, r75, cb0[14].zzzz\n\
+    iadd r76, r75, r19\n\
+    iadd r2, r2, r76\n\
+    iadd r6, r76, r77\n\
+\n\
+    ; blend word 59\n\
+    bitalign r75, r21, r21, l5.zzzz\n\
+    bitalign r76, r21, r21, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r21, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r18, r18, l5.wwww\n\
+    bitalign r75, r18, r18, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r18, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r20\n\
+    iadd r20, r75, r13\n\
+\n\
+    ; step 59\n\
+    bitalign r75, r6, r6, l5.xxxx\n\
+    bitalign r76, r6, r6, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r6, r6, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r6, r7\n\
+    ibit_extract r75, r6, r8, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r2, r2, l5.yyyy\n\
+    bitalign r76, r2, r2, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r2, r2, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r4, r3, r2\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r5\n\
+    iadd r75, r75, cb0[14].wwww\n\
+    iadd r76, r75, r20\n\
+    iadd r1, r1, r76\n\
+    iadd r5, r76, r77\n\
+\n\
+    ; blend word 60\n\
+    bitalign r75, r22, r22, l5.zzzz\n\
+    bitalign r76, r22, r22, l6.zzzz\n\
+    ixor r75, r75, r76\n\
+    ushr r76, r22, l7.zzzz\n\
+    ixor r77, r75, r76\n\
+    bitalign r76, r19, r19, l5.wwww\n\
+    bitalign r75, r19, r19, l6.wwww\n\
+    ixor r76, r76, r75\n\
+    ushr r75, r19, l7.wwww\n\
+    ixor r76, r76, r75\n\
+    iadd r75, r77, r76\n\
+    iadd r75, r75, r21\n\
+    iadd r21, r75, r14\n\
+\n\
+    ; step 60\n\
+    bitalign r75, r5, r5, l5.xxxx\n\
+    bitalign r76, r5, r5, l6.xxxx\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r5, r5, l7.xxxx\n\
+    ixor r77, r75, r76\n\
+    ixor r75, r5, r6\n\
+    ibit_extract r75, r5, r7, r75\n\
+    iadd r77, r77, r75\n\
+    bitalign r75, r1, r1, l5.yyyy\n\
+    bitalign r76, r1, r1, l6.yyyy\n\
+    ixor r75, r75, r76\n\
+    bitalign r76, r1, r1, l7.yyyy\n\
+    ixor r78, r75, r76\n\
+    ibit_extract r76, r3, r2, r1\n\
+    iadd r75, r78, r76\n\
+    iadd r75, r75, r4\n\
+    iadd r75, r75, cb0[15].xxxx\n\
+    iadd r76, r75, r21\n\
+    iadd r8, r8, r76\n\
+    iadd r4, r76, r77\n\
+\n\
+    ; add A,B,C,D,E,F,G,H to intermediate hash values\n\
+    iadd r1, r1, l8.xxxx\n\
+    iadd r2, r2, l8.yyyy\n\
+    iadd r3, r3, l8.zzzz\n\
+    iadd r4, r4, l8.wwww\n\
+    iadd r5, r5, l9.xxxx\n\
+    iadd r6, r6, l9.yyyy\n\
+    iadd r7, r7, l9.zzzz\n\
+    iadd r8, r8, l9.wwww\n\
+\n\
+    ; set bits in r75 if H is zero for a component still scanning\n\
+    ieq r75, r8, l0.zzzz\n\
+    iand r75, r75, r79\n\
+    ior r76.xy, r75.xy, r75.zw\n\
+    ior r76.x, r76.x, r76.y\n\
+    if_logicalnz r76.x\n\
+      if_logicalnz r75.x\n\
+        uav_read_add_id(1) r80.x, l14.x, l0.w\n\
+        umin r80.x, r80.x, l14.y\n\
+        umad r80.x, r80.x, l14.z, l14.w\n\
+        mov r81.x, r73.x\n\
+        ishl r81.y, vAbsTidFlat.x, l5.x\n\
+        iadd r81.y, r81.y, l15.x\n\
+        uav_raw_store_id(1) mem.xy__, r80.x, r81\n\
+      endif\n\
+      if_logicalnz r75.y\n\
+        uav_read_add_id(1) r80.x, l14.x, l0.w\n\
+        umin r80.x, r80.x, l14.y\n\
+        umad r80.x, r80.x, l14.z, l14.w\n\
+        mov r81.x, r73.y\n\
+        ishl r81.y, vAbsTidFlat.x, l5.x\n\
+        iadd r81.y, r81.y, l15.y\n\
+        uav_raw_store_id(1) mem.xy__, r80.x, r81\n\
+      endif\n\
+      if_logicalnz r75.z\n\
+        uav_read_add_id(1) r80.x, l14.x, l0.w\n\
+        umin r80.x, r80.x, l14.y\n\
+        umad r80.x, r80.x, l14.z, l14.w\n\
+        mov r81.x, r73.z\n\
+        ishl r81.y, vAbsTidFlat.x, l5.x\n\
+        iadd r81.y, r81.y, l15.z\n\
+        uav_raw_store_id(1) mem.xy__, r80.x, r81\n\
+      endif\n\
+      if_logicalnz r75.w\n\
+        uav_read_add_id(1) r80.x, l14.x, l0.w\n\
+        umin r80.x, r80.x, l14.y\n\
+        umad r80.x, r80.x, l14.z, l14.w\n\
+        mov r81.x, r73.w\n\
+        ishl r81.y, vAbsTidFlat.x, l5.x\n\
+        iadd r81.y, r81.y, l15.w\n\
+        uav_raw_store_id(1) mem.xy__, r80.x, r81\n\
+      endif\n\
+    endif\n\
+\n\
+    ; increment iteration counter, and the nonce of the components still\n\
+    ; scanning (r79 is -1 for them)\n\
+    iadd r0.y, r0.y, l0.w\n\
+    isub r73, r73, r79\n\
+\n\
+    ; break if we have iterated too many times\n\
+    ieq r75.x, r0.y, r0.z\n\
+    break_logicalnz r75.x\n\
+  endloop\n\
+\n\
+  mov g[r0.x+0].y, r73.x\n\
+  mov g[r0.x+1].y, r73.y\n\
+  mov g[r0.x+2].y, r73.z\n\
+  mov g[r0.x+3].y, r73.w\n\
+endmain\n\
+end\n\
+"
@@ -8,11 +8,14 @@ use strict;
 
 my $code;
 my $elm_per_threads = 4; # keep in sync with ELM_PER_THREAD in C code
+my $result_slots = 6; # keep in sync with RESULT_SLOTS in C code
 my ($zero, $zero_e, $one, $one_e, $s_found, $s_finished,
     $tmp0, $tmp1, $tmp2, $tmp3);
 my ($v2, $v6, $v7, $v17);
 my ($v13, $v11, $v18, $v19);
 my ($v22, $v25, $v3, $v10);
+# per-work values: dcl_literal (l3, l4, l10-l13) or constant buffer (cb1)
+my ($mid0, $mid1, $st0, $st1, $pre, $pre31);
 
 # Returns the constant k[i] used in the given step (cb0[?].?).
 #
@@ -25,6 +28,23 @@ sub step_to_k_i
     return sprintf "cb0[%i].%s", $step / 4, $elm[$step % 4];
 }
 
+# Host-side sigma functions, to fold the blending of constant data words
+sub ror32
+{
+    my ($x, $n) = @_;
+    return (($x >> $n) | ($x << (32 - $n))) & 0xffffffff;
+}
+sub sigma0_const
+{
+    my ($x) = @_;
+    return sprintf "0x%08x", ror32($x, 7) ^ ror32($x, 18) ^ ($x >> 3);
+}
+sub sigma1_const
+{
+    my ($x) = @_;
+    return sprintf "0x%08x", ror32($x, 17) ^ ror32($x, 19) ^ ($x >> 10);
+}
+
 # Returns the register containing the given data word
 #
 # $i 0..63
@@ -38,6 +58,21 @@ sub w
     return sprintf 'r%d', (9 + $i);
 }
 
+# Returns the operand holding the data word used in the given step, or undef
+# if the word is zero. Words 4-15 of both hashes are the padding, so they are
+# literals (the first hash does not use words 0-3 since it starts at step 4).
+#
+# $num 0 (first hash) or 1 (second hash)
+# $step 0..63
+sub w_step
+{
+    my ($num, $step) = @_;
+    return w($step) if $step >= 16 or ($num == 1 and $step < 8);
+    return 'l2.zzzz' if $step == ($num == 0 ? 4 : 8); # end-of-message bit
+    return ($num == 0 ? 'l2.wwww' : 'l1.zzzz') if $step == 15; # bit length
+    return undef;
+}
+
 # Returns the register holding the given intermediate hash value.
 #
 # $ihv a..h
@@ -76,12 +111,23 @@ sub sigma1
 
 # compute a word by blending previous ones: w[i] = s0 + s1 + w[i-16] + w[i-7]
 #
+# Words 16-31 read some of the constant words 4-15, and are blended by
+# sha256_blend_first or sha256_blend_second instead.
+#
 # $i 16..63 word to blend
 sub sha256_blend
 {
-    my ($i) = @_;
+    my ($num, $i) = @_;
     die "*bug*: i is too small" if $i < 16;
     $code .= "\n    ; blend word $i\n";
+    if ($i < 32) {
+        if ($num == 0) {
+            sha256_blend_first($i);
+        } else {
+            sha256_blend_second($i);
+        }
+        return;
+    }
     sigma0(w($i - 15));
     sigma1(w($i - 2));
     $code .=
@@ -90,6 +136,86 @@ sub sha256_blend
     "    iadd ".w($i).", $tmp0, ".w($i - 7)."\n";
 }
 
+# blend word 16..31 of the first hash: words 0-2 are the same for every nonce,
+# so the host precomputes words 16-17 and the nonce-independent parts of words
+# 18, 19 and 31 ($pre, $pre31), and words 4-15 are the padding
+sub sha256_blend_first
+{
+    my ($i) = @_;
+    if ($i == 16 or $i == 17) {
+        $code .= "    mov ".w($i).", $pre.".(qw/xxxx yyyy/)[$i - 16]."\n";
+    } elsif ($i == 18) {
+        sigma0('r73');
+        $code .= "    iadd ".w($i).", $tmp2, $pre.zzzz\n";
+    } elsif ($i == 19) {
+        $code .= "    iadd ".w($i).", r73, $pre.wwww\n";
+    } else {
+        sigma1(w($i - 2));
+        if ($i == 20) {
+            $code .= "    iadd ".w($i).", $tmp1, l2.zzzz\n";
+        } elsif ($i == 21) {
+            $code .= "    mov ".w($i).", $tmp1\n";
+        } elsif ($i == 22) {
+            $code .= "    iadd ".w($i).", $tmp1, l2.wwww\n";
+        } elsif ($i < 30) {
+            $code .= "    iadd ".w($i).", $tmp1, ".w($i - 7)."\n";
+        } else {
+            $code .=
+            "    iadd $tmp0, $tmp1, ".w($i - 7)."\n".
+            "    iadd ".w($i).", $tmp0, ".($i == 30 ? 'l13.yyyy' : $pre31)."\n";
+        }
+    }
+}
+
+# blend word 16..31 of the second hash: words 8-15 are the padding, and the
+# sigmas of its non-zero words are folded in l1, l2 and l13
+sub sha256_blend_second
+{
+    my ($i) = @_;
+    if ($i == 16) {
+        sigma0(w(1));
+        $code .= "    iadd ".w($i).", $tmp2, ".w(0)."\n";
+    } elsif ($i == 17) {
+        sigma0(w(2));
+        $code .=
+        "    iadd $tmp0, $tmp2, ".w(1)."\n".
+        "    iadd ".w($i).", $tmp0, l2.xxxx\n";
+    } elsif ($i <= 22) {
+        sigma0(w($i - 15));
+        sigma1(w($i - 2));
+        $code .=
+        "    iadd $tmp0, $tmp2, $tmp1\n".
+        "    iadd ".w($i).", $tmp0, ".w($i - 16)."\n";
+        $code .= "    iadd ".w($i).", ".w($i).", l1.zzzz\n" if $i == 22;
+    } elsif ($i == 23) {
+        sigma1(w($i - 2));
+        $code .=
+        "    iadd $tmp0, $tmp1, ".w(16)."\n".
+        "    iadd $tmp0, $tmp0, ".w(7)."\n".
+        "    iadd ".w($i).", $tmp0, l2.yyyy\n";
+    } elsif ($i == 24) {
+        sigma1(w($i - 2));
+        $code .=
+        "    iadd $tmp0, $tmp1, ".w(17)."\n".
+        "    iadd ".w($i).", $tmp0, l2.zzzz\n";
+    } elsif ($i < 30) {
+        sigma1(w($i - 2));
+        $code .= "    iadd ".w($i).", $tmp1, ".w($i - 7)."\n";
+    } elsif ($i == 30) {
+        sigma1(w($i - 2));
+        $code .=
+        "    iadd $tmp0, $tmp1, ".w($i - 7)."\n".
+        "    iadd ".w($i).", $tmp0, l1.wwww\n";
+    } else {
+        sigma0(w(16));
+        sigma1(w($i - 2));
+        $code .=
+        "    iadd $tmp0, $tmp2, $tmp1\n".
+        "    iadd $tmp0, $tmp0, ".w($i - 7)."\n".
+        "    iadd ".w($i).", $tmp0, l1.zzzz\n";
+    }
+}
+
 # tmp2 = ror32(x, 2) ^ ror32(x,13) ^ ror32(x,22)
 sub bigsigma0
 {
@@ -164,17 +290,18 @@ sub ch
 # implement a SHA-256 round
 sub sha256_round
 {
-    my ($step) = @_;
-    my $a = ihv_reg($_[1]);
-    my $b = ihv_reg($_[2]);
-    my $c = ihv_reg($_[3]);
-    my $d = ihv_reg($_[4]);
-    my $e = ihv_reg($_[5]);
-    my $f = ihv_reg($_[6]);
-    my $g = ihv_reg($_[7]);
-    my $h = ihv_reg($_[8]);
+    my ($num, $step) = @_;
+    my $a = ihv_reg($_[2]);
+    my $b = ihv_reg($_[3]);
+    my $c = ihv_reg($_[4]);
+    my $d = ihv_reg($_[5]);
+    my $e = ihv_reg($_[6]);
+    my $f = ihv_reg($_[7]);
+    my $g = ihv_reg($_[8]);
+    my $h = ihv_reg($_[9]);
     my $k_i = step_to_k_i($step);
-    sha256_blend($step) if $step >= 16;
+    my $w = w_step($num, $step);
+    sha256_blend($num, $step) if $step >= 16;
     $code .= "\n    ; step $step\n";
     bigsigma0($a);
     maj($step, $a, $b, $c);
@@ -183,94 +310,140 @@ sub sha256_round
     ch($step, $e, $f, $g);
     $code .=
     "    iadd $tmp0, $tmp3, $tmp1\n".
-    "    iadd $tmp0, $tmp0, $h\n".
-    "    iadd $tmp0, $tmp0, $k_i\n".
-    "    iadd $tmp1, $tmp0, ".w($step)."\n"; # this is t1
+    "    iadd $tmp0, $tmp0, $h\n";
+    if (defined $w) {
+        $code .=
+        "    iadd $tmp0, $tmp0, $k_i\n".
+        "    iadd $tmp1, $tmp0, $w\n"; # this is t1
+    } else {
+        $code .= "    iadd $tmp1, $tmp0, $k_i\n"; # this is t1
+    }
     # d = d + t1
     $code .= "    iadd $d, $d, $tmp1\n";
     # h = t1 + t2
     $code .= "    iadd $h, $tmp1, $tmp2\n";
 }
 
+# Executes the steps of one hash. The first hash starts at step 4 from the
+# state precomputed by the host (only the nonce needs to be added to A and E).
 sub execute_64rounds
 {
     my ($num) = @_;
+    my @ihv = qw/a b c d e f g h/;
+    # this optimization (only executing the last 3 rounds of the first hash)
+    # is technically not necessary to be made explicitely because the CAL
+    # compiler is able to get rid of this unnecessary code by itself
+    my $last = $num == 0 ? 63 : 60;
+    for (my $s = $num == 0 ? 4 : 0; $s <= $last; $s++) {
+        # the names of A..H rotate by one register every step
+        my $r = $s % 8;
+        sha256_round($num, $s, @ihv[(8 - $r) .. 7], @ihv[0 .. (7 - $r)]);
+    }
+}
+
+# End of the main loop, then write back of the status and current nonce of
+# every element
+sub status_tail
+{
+    $code .= <<EOF;
+    ; increment iteration counter and nonce
+    iadd r0.y, r0.y, $one_e
+    iadd r73, r73, $one
+
+    ; set bits in $tmp0 if H is zero
+    ieq $tmp0, r8, $zero
+
+    ; set bits in $tmp0 if we have iterated too many times
+    ieq $tmp1.x, r0.y, r0.z
+    ior $tmp0.x, $tmp0.x, $tmp1.x
+
+    ; set bits in $tmp0 if we have reach the end nonce
+    ieq $tmp1, r73, r74
+    ior $tmp0, $tmp0, $tmp1
+
+    ; if $tmp0 has any bit set, break
+    ior $tmp0.xy, $tmp0.xy, $tmp0.zw
+    ior $tmp0.x, $tmp0.x, $tmp0.y
+    break_logicalnz $tmp0.x
+  endloop
+
+EOF
+    my $i = 0;
+    foreach my $c (qw/x y z w/) {
+	my $status = sprintf 'g[r0.x+%d].x', $i;
+	my $cur_nonce = sprintf 'g[r0.x+%d].y', $i;
+	$code .= <<EOF;
+  ; looking at component $c
+  mov $status, $zero_e ; s_searching
+  if_logicalz r8.$c
+    mov $status, $s_found
+  else
+    ieq $tmp0.x, r73.$c, r74.$c
+    if_logicalnz $tmp0.x
+      mov $status, $s_finished
+    endif
+  endif
+  mov $cur_nonce, r73.$c
+EOF
+	$i++;
+    }
+}
 
-    my $s = 0;
-    sha256_round($s++, qw/a b c d e f g h/);
-    sha256_round($s++, qw/h a b c d e f g/);
-    sha256_round($s++, qw/g h a b c d e f/);
-    sha256_round($s++, qw/f g h a b c d e/);
-    sha256_round($s++, qw/e f g h a b c d/);
-    sha256_round($s++, qw/d e f g h a b c/);
-    sha256_round($s++, qw/c d e f g h a b/);
-    sha256_round($s++, qw/b c d e f g h a/);
-    sha256_round($s++, qw/a b c d e f g h/);
-    sha256_round($s++, qw/h a b c d e f g/);
-    sha256_round($s++, qw/g h a b c d e f/);
-    sha256_round($s++, qw/f g h a b c d e/);
-    sha256_round($s++, qw/e f g h a b c d/);
-    sha256_round($s++, qw/d e f g h a b c/);
-    sha256_round($s++, qw/c d e f g h a b/);
-    sha256_round($s++, qw/b c d e f g h a/);
-    sha256_round($s++, qw/a b c d e f g h/);
-    sha256_round($s++, qw/h a b c d e f g/);
-    sha256_round($s++, qw/g h a b c d e f/);
-    sha256_round($s++, qw/f g h a b c d e/);
-    sha256_round($s++, qw/e f g h a b c d/);
-    sha256_round($s++, qw/d e f g h a b c/);
-    sha256_round($s++, qw/c d e f g h a b/);
-    sha256_round($s++, qw/b c d e f g h a/);
-    sha256_round($s++, qw/a b c d e f g h/);
-    sha256_round($s++, qw/h a b c d e f g/);
-    sha256_round($s++, qw/g h a b c d e f/);
-    sha256_round($s++, qw/f g h a b c d e/);
-    sha256_round($s++, qw/e f g h a b c d/);
-    sha256_round($s++, qw/d e f g h a b c/);
-    sha256_round($s++, qw/c d e f g h a b/);
-    sha256_round($s++, qw/b c d e f g h a/);
-    sha256_round($s++, qw/a b c d e f g h/);
-    sha256_round($s++, qw/h a b c d e f g/);
-    sha256_round($s++, qw/g h a b c d e f/);
-    sha256_round($s++, qw/f g h a b c d e/);
-    sha256_round($s++, qw/e f g h a b c d/);
-    sha256_round($s++, qw/d e f g h a b c/);
-    sha256_round($s++, qw/c d e f g h a b/);
-    sha256_round($s++, qw/b c d e f g h a/);
-    sha256_round($s++, qw/a b c d e f g h/);
-    sha256_round($s++, qw/h a b c d e f g/);
-    sha256_round($s++, qw/g h a b c d e f/);
-    sha256_round($s++, qw/f g h a b c d e/);
-    sha256_round($s++, qw/e f g h a b c d/);
-    sha256_round($s++, qw/d e f g h a b c/);
-    sha256_round($s++, qw/c d e f g h a b/);
-    sha256_round($s++, qw/b c d e f g h a/);
-    sha256_round($s++, qw/a b c d e f g h/);
-    sha256_round($s++, qw/h a b c d e f g/);
-    sha256_round($s++, qw/g h a b c d e f/);
-    sha256_round($s++, qw/f g h a b c d e/);
-    sha256_round($s++, qw/e f g h a b c d/);
-    sha256_round($s++, qw/d e f g h a b c/);
-    sha256_round($s++, qw/c d e f g h a b/);
-    sha256_round($s++, qw/b c d e f g h a/);
-    sha256_round($s++, qw/a b c d e f g h/);
-    sha256_round($s++, qw/h a b c d e f g/);
-    sha256_round($s++, qw/g h a b c d e f/);
-    sha256_round($s++, qw/f g h a b c d e/);
-    sha256_round($s++, qw/e f g h a b c d/);
-    if ($num == 0) {
-        # this optimization (only executing the last 3 rounds of the first hash)
-        # is technically not necessary to be made explicitely because the CAL
-        # compiler is able to get rid of this unnecessary code by itself
-        sha256_round($s++, qw/d e f g h a b c/);
-        sha256_round($s++, qw/c d e f g h a b/);
-        sha256_round($s++, qw/b c d e f g h a/);
+# End of the main loop, appending the candidates to uav1, then write back of
+# the current nonce of every element
+sub compact_tail
+{
+    $code .= <<EOF;
+    ; set bits in $tmp0 if H is zero for a component still scanning
+    ieq $tmp0, r8, $zero
+    iand $tmp0, $tmp0, r79
+    ior $tmp1.xy, $tmp0.xy, $tmp0.zw
+    ior $tmp1.x, $tmp1.x, $tmp1.y
+    if_logicalnz $tmp1.x
+EOF
+    foreach my $c (qw/x y z w/) {
+	$code .= <<EOF;
+      if_logicalnz $tmp0.$c
+        uav_read_add_id(1) r80.x, l14.x, $one_e
+        umin r80.x, r80.x, l14.y
+        umad r80.x, r80.x, l14.z, l14.w
+        mov r81.x, r73.$c
+        ishl r81.y, vAbsTidFlat.x, l5.x
+        iadd r81.y, r81.y, l15.$c
+        uav_raw_store_id(1) mem.xy__, r80.x, r81
+      endif
+EOF
+    }
+    $code .= <<EOF;
+    endif
+
+    ; increment iteration counter, and the nonce of the components still
+    ; scanning (r79 is -1 for them)
+    iadd r0.y, r0.y, $one_e
+    isub r73, r73, r79
+
+    ; break if we have iterated too many times
+    ieq $tmp0.x, r0.y, r0.z
+    break_logicalnz $tmp0.x
+  endloop
+
+EOF
+    my $i = 0;
+    foreach my $c (qw/x y z w/) {
+	$code .= sprintf "  mov g[r0.x+%d].y, r73.$c\n", $i;
+	$i++;
     }
 }
 
+# $cbuf 0: per-work values are literals, the kernel is compiled for each work
+#       item; 1: they are read from cb1, the kernel is compiled once
+# $compact 0: the status and current nonce of every element are written back
+#       to g[]; 1: each element scans exactly min(iterations, nonces left),
+#       candidates are appended to the result buffer uav1 and g[] only keeps
+#       the current nonces for the next run
 sub generate_kernel
 {
-    my ($fname) = @_;
+    my ($fname, $cbuf, $compact) = @_;
     $zero_e = 'l0.z';
     $zero = $zero_e.'zzz';
     $one_e = 'l0.w';
@@ -280,44 +453,96 @@ sub generate_kernel
     ($v2, $v6, $v7, $v17) =    qw/l5.xxxx l5.yyyy l5.zzzz l5.wwww/;
     ($v13, $v11, $v18, $v19) = qw/l6.xxxx l6.yyyy l6.zzzz l6.wwww/;
     ($v22, $v25, $v3, $v10) =  qw/l7.xxxx l7.yyyy l7.zzzz l7.wwww/;
+    my $work_decl;
+    if ($cbuf) {
+        ($mid0, $mid1, $st0, $st1, $pre, $pre31) =
+            ('cb1[0]', 'cb1[1]', 'cb1[2]', 'cb1[3]', 'cb1[4]', 'cb1[5].xxxx');
+        $work_decl = <<EOF;
+  ;  cb1 per-work values, written by the host for each work item
+  ;  cb1[0-1] SHA256 intermediate hash values (for first hash)
+  ;  cb1[2-3] A,B,C,D,E,F,G,H after step 3 of the first hash for nonce 0
+  ;  cb1[4].x-y data words 16-17 of the first hash
+  ;  cb1[4].z data word 18 minus s0(nonce)
+  ;  cb1[4].w data word 19 minus nonce
+  ;  cb1[5].x s0(word 16) + word 15, part of data word 31
+  dcl_cb cb1[8]
+  ;  l13.y s0(l2.w)
+  dcl_literal l13, 0, ${\ sigma0_const(0x280)}, 0, 0
+EOF
+    } else {
+        ($mid0, $mid1, $st0, $st1, $pre, $pre31) =
+            ('l3', 'l4', 'l10', 'l11', 'l12', 'l13.xxxx');
+        $work_decl = <<EOF;
+  ;  l3-l4 SHA256 intermediate hash values (for first hash)
+  dcl_literal l3, %u, %u, %u, %u
+  dcl_literal l4, %u, %u, %u, %u
+  ;  l10-l11 A,B,C,D,E,F,G,H after step 3 of the first hash for nonce 0
+  dcl_literal l10, %u, %u, %u, %u
+  dcl_literal l11, %u, %u, %u, %u
+  ;  l12.x-y data words 16-17 of the first hash
+  ;  l12.z data word 18 minus s0(nonce)
+  ;  l12.w data word 19 minus nonce
+  dcl_literal l12, %u, %u, %u, %u
+  ;  l13.x s0(word 16) + word 15, part of data word 31
+  ;  l13.y s0(l2.w)
+  dcl_literal l13, %u, ${\ sigma0_const(0x280)}, 0, 0
+EOF
+    }
     $code = "";
     $code .= <<EOF;
 il_cs
   dcl_num_thread_per_group %d
   ;  SHA256 round constants
   dcl_cb cb0[16]
-  ;  l0.x number of iterations
+  ;  l0.x unused
   ;  l0.y used to access g[], must be sizeof (thread_state_t) / 16
   ;  $zero_e 0, used in various places
   ;  $one_e 1, used in various places
-  dcl_literal l0, %u, %lu, 0, 1
+  dcl_literal l0, 0, %lu, 0, 1
   ;  $s_found value of s_found
   ;  $s_finished value of s_finished
   ;  l1.z msg length in bits for second hash (ie. word 15)
-  ;  l1.w data word 0
-  dcl_literal l1, %d, %d, 0x100, %u
-  ;  l2.x data word 1
-  ;  l2.y data word 2
+  ;  l1.w s0(l1.z)
+  dcl_literal l1, %d, %d, 0x100, ${\ sigma0_const(0x100)}
+  ;  l2.x s1(l1.z)
+  ;  l2.y s0(l2.z)
   ;  l2.z data word 4 (end-of-msg bit, re-used for second hash too)
   ;  l2.w data msg length in bits for first hash (ie. word 15)
-  dcl_literal l2, %u, %u, 0x80000000, 0x280
-  ;  l3-l4 SHA256 intermediate hash values (for first hash)
-  dcl_literal l3, %u, %u, %u, %u
-  dcl_literal l4, %u, %u, %u, %u
-  ;  l5-l7 rotate and shift values
+  dcl_literal l2, ${\ sigma1_const(0x100)}, ${\ sigma0_const(0x80000000)}, 0x80000000, 0x280
+$work_decl  ;  l5-l7 rotate and shift values
   dcl_literal l5, 2, 6, 7, 17
   dcl_literal l6, 13, 11, 18, 19
   dcl_literal l7, 22, 25, 3, 10
   ;  l8-l9 SHA256 initial hash values (for second hash)
   dcl_literal l8, 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a
   dcl_literal l9, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+EOF
+    $code .= <<EOF if $compact;
+  ;  uav1 result buffer: the number of candidates in its first dword, then
+  ;  $result_slots slots of 8 bytes (nonce, element index) from byte 16
+  dcl_raw_uav_id(1)
+  ;  l14.x byte address of the counter
+  ;  l14.y last slot, re-used by the candidates overflowing
+  ;  l14.z size of a slot
+  ;  l14.w byte address of the first slot
+  dcl_literal l14, 0, ${\ ($result_slots - 1)}, 8, 16
+  ;  l15 element index of each component, minus 4 * thread index
+  dcl_literal l15, 0, 1, 2, 3
+EOF
+    $code .= <<EOF;
 
   ; r0.x    offset to this thread's state in g[]
   ; r0.y    iteration counter
+  ; r0.z    number of iterations, set by the host in the table of each run
   ; r1-r8   A,B,C,D,E,F,G,H
   ; r9-r24  16 data words, re-used to process all 64 data words
   ; r73     current nonce
   ; r74     end nonce
+EOF
+    $code .= <<EOF if $compact;
+  ; r79     components still scanning
+  ; r80     byte address of the slot of a candidate
+  ; r81     candidate (nonce, element index)
 EOF
     $tmp0 = 'r75';
     $tmp1 = 'r76';
@@ -330,6 +555,7 @@ EOF
   ; $tmp3   temp value
 
   umul r0.x, vAbsTidFlat.x, l0.y
+  mov r0.z, g[r0.x+0].w
 
   ; load current nonce
   mov r73.x, g[r0.x+0].y
@@ -345,35 +571,30 @@ EOF
   ixor r0.y, r0.y, r0.y
 
   whileloop
-    ; load data words 0-4
-    mov r9, l1.wwww
-    mov r10, l2.xxxx
-    mov r11, l2.yyyy
-    mov r12, r73     ; current nonce
-    mov r13, l2.zzzz
-    ; load data words 5-14 (all zero)
-    mov r14, $zero
-    mov r15, $zero
-    mov r16, $zero
-    mov r17, $zero
-    mov r18, $zero
-    mov r19, $zero
-    mov r20, $zero
-    mov r21, $zero
-    mov r22, $zero
-    mov r23, $zero
-    ; load data word 15 (bit length)
-    mov r24, l2.wwww
+EOF
+    $code .= <<EOF if $compact;
+    ; set bits in r79 for the components that did not reach their end
+    ; nonce, and break if there is none
+    ine r79, r73, r74
+    ior $tmp0.xy, r79.xy, r79.zw
+    ior $tmp0.x, $tmp0.x, $tmp0.y
+    break_logicalz $tmp0.x
 
-    ; init intermediate hash values
-    mov r1, l3.xxxx
-    mov r2, l3.yyyy
-    mov r3, l3.zzzz
-    mov r4, l3.wwww
-    mov r5, l4.xxxx
-    mov r6, l4.yyyy
-    mov r7, l4.zzzz
-    mov r8, l4.wwww
+EOF
+    $code .= <<EOF;
+    ; data words 0-15 are not loaded: words 0-3 were used by steps 0-3
+    ; (precomputed), and words 4-15 are literals
+
+    ; init intermediate hash values from the state after step 3, named as
+    ; they are used by step 4; the nonce (word 3) adds to A and E
+    iadd r5, $st0.xxxx, r73
+    mov r6, $st0.yyyy
+    mov r7, $st0.zzzz
+    mov r8, $st0.wwww
+    iadd r1, $st1.xxxx, r73
+    mov r2, $st1.yyyy
+    mov r3, $st1.zzzz
+    mov r4, $st1.wwww
 
 EOF
 
@@ -383,24 +604,16 @@ EOF
 
     ; add A,B,C,D,E,F,G,H to intermediate hash values, and store them in
     ; data words for next SHA-256 hash computation
-    iadd r9, r1, l3.xxxx
-    iadd r10, r2, l3.yyyy
-    iadd r11, r3, l3.zzzz
-    iadd r12, r4, l3.wwww
-    iadd r13, r5, l4.xxxx
-    iadd r14, r6, l4.yyyy
-    iadd r15, r7, l4.zzzz
-    iadd r16, r8, l4.wwww
-    ; init rest of the data words
-    mov r17, l2.zzzz ; end-of-message bit
-    ; r18-r23 reset to zero
-    mov r18, $zero
-    mov r19, $zero
-    mov r20, $zero
-    mov r21, $zero
-    mov r22, $zero
-    mov r23, $zero
-    mov r24, l1.zzzz
+    iadd r9, r1, $mid0.xxxx
+    iadd r10, r2, $mid0.yyyy
+    iadd r11, r3, $mid0.zzzz
+    iadd r12, r4, $mid0.wwww
+    iadd r13, r5, $mid1.xxxx
+    iadd r14, r6, $mid1.yyyy
+    iadd r15, r7, $mid1.zzzz
+    iadd r16, r8, $mid1.wwww
+    ; the rest of the data words (end-of-message bit, zeros, bit length) are
+    ; literals
 
     ; init intermediate hash values
     mov r1, l8.xxxx
@@ -428,53 +641,14 @@ EOF
     iadd r7, r7, l9.zzzz
     iadd r8, r8, l9.wwww
 
-    ; increment iteration counter and nonce
-    iadd r0.y, r0.y, $one_e
-    iadd r73, r73, $one
-
-    ; set bits in $tmp0 if H is zero
-    ieq $tmp0, r8, $zero
-
-    ; set bits in $tmp0 if we have iterated too many times
-    ieq $tmp1.x, r0.y, l0.x
-    ior $tmp0.x, $tmp0.x, $tmp1.x
-
-    ; set bits in $tmp0 if we have reach the end nonce
-    ieq $tmp1, r73, r74
-    ior $tmp0, $tmp0, $tmp1
-
-    ; if $tmp0 has any bit set, break
-    ior $tmp0.xy, $tmp0.xy, $tmp0.zw
-    ior $tmp0.x, $tmp0.x, $tmp0.y
-    break_logicalnz $tmp0.x
-  endloop
-
 EOF
-    $code .= " mov g[r0.x+0].w, r8.x ; DEBUG\n";
-
-    my $i = 0;
-    foreach my $c (qw/x y z w/) {
-	my $status = sprintf 'g[r0.x+%d].x', $i;
-	my $cur_nonce = sprintf 'g[r0.x+%d].y', $i;
-	$code .= <<EOF;
-  ; looking at component $c
-  mov $status, $zero_e ; s_searching
-  if_logicalz r8.$c
-    mov $status, $s_found
-  else
-    ieq $tmp0.x, r73.$c, r74.$c
-    if_logicalnz $tmp0.x
-      mov $status, $s_finished
-    endif
-  endif
-  mov $cur_nonce, r73.$c
-EOF
-	$i++;
+    if ($compact) {
+        compact_tail();
+    } else {
+        status_tail();
     }
     $code .= <<EOF;
 endmain
-
-;_the_end_
 end
 EOF
 
@@ -502,5 +676,8 @@ EOF
     close($fh) or die "can't close $fname: $!";
 }
 
-generate_kernel("kernel-sha256.h");
+generate_kernel("kernel-sha256.h", 0, 0);
+generate_kernel("kernel-sha256-cbuf.h", 1, 0);
+generate_kernel("kernel-sha256-compact.h", 0, 1);
+generate_kernel("kernel-sha256-cbuf-compact.h", 1, 1);
 # eof
@@ -0,0 +1,225 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "nonce-sched.h"
+
+static uint64_t left(const nonce_sched_t *s, int elm)
+{
+    return s->ranges[elm].end - s->ranges[elm].cur;
+}
+
+/*
+ * Nonces that can be taken from an element: all it has left, but those its
+ * current run may scan.
+ */
+static uint64_t spare(const nonce_sched_t *s, int elm)
+{
+    uint64_t n = left(s, elm);
+    if (!s->running[elm])
+        return n;
+    return n > s->max_run ? n - s->max_run : 0;
+}
+
+/*
+ * Max-heap of the elements still scanning, keyed by their spare nonces.
+ */
+static void sift_down(nonce_sched_t *s, int i)
+{
+    int *h = s->heap;
+    for (;;)
+      {
+        int c = 2 * i + 1;
+        if (c >= s->heap_len)
+            break;
+        if (c + 1 < s->heap_len && spare(s, h[c + 1]) > spare(s, h[c]))
+            c++;
+        if (spare(s, h[c]) <= spare(s, h[i]))
+            break;
+        int tmp = h[c]; h[c] = h[i]; h[i] = tmp;
+        i = c;
+      }
+}
+
+static void heap_push(nonce_sched_t *s, int elm)
+{
+    int *h = s->heap;
+    int i = s->heap_len++;
+    h[i] = elm;
+    while (i && spare(s, h[(i - 1) / 2]) < spare(s, h[i]))
+      {
+        int p = (i - 1) / 2;
+        int tmp = h[p]; h[p] = h[i]; h[i] = tmp;
+        i = p;
+      }
+}
+
+static int heap_pop(nonce_sched_t *s)
+{
+    int top = s->heap[0];
+    s->heap[0] = s->heap[--s->heap_len];
+    sift_down(s, 0);
+    return top;
+}
+
+void nonce_sched_init(nonce_sched_t *s, int nr_elms, uint32_t chunk,
+        uint32_t min_split, uint32_t max_run)
+{
+    s->nr_elms = nr_elms;
+    s->chunk = chunk ? chunk : 1;
+    s->min_split = min_split ? min_split : 1;
+    s->max_run = max_run;
+    s->ranges = calloc(nr_elms, sizeof (*s->ranges));
+    s->parked = calloc(nr_elms, sizeof (*s->parked));
+    s->running = calloc(nr_elms, sizeof (*s->running));
+    s->heap = calloc(nr_elms, sizeof (*s->heap));
+    s->todo = NULL;
+    s->nr_todo = s->max_todo = 0;
+    if (!s->ranges || !s->parked || !s->running || !s->heap)
+        perror("calloc"), exit(1);
+    nonce_sched_reset(s, NULL, 0);
+}
+
+/*
+ * Starts a new work item, of which the nr ranges in todo[] are to be scanned
+ * (NULL means all 2^32 nonces). Nothing is handed out yet.
+ */
+void nonce_sched_reset(nonce_sched_t *s, const nonce_range_t *todo, int nr)
+{
+    const nonce_range_t all = { 0, (uint64_t)1 << 32 };
+    if (!todo)
+      {
+        todo = &all;
+        nr = 1;
+      }
+    if (nr > s->max_todo)
+      {
+        s->max_todo = nr;
+        s->todo = realloc(s->todo, nr * sizeof (*s->todo));
+        if (!s->todo)
+            perror("realloc"), exit(1);
+      }
+    // handed out from the end of the list
+    for (int i = 0; i < nr; i++)
+        s->todo[i] = todo[nr - 1 - i];
+    s->nr_todo = nr;
+    memset(s->ranges, 0, s->nr_elms * sizeof (*s->ranges));
+    memset(s->parked, 0, s->nr_elms * sizeof (*s->parked));
+    memset(s->running, 0, s->nr_elms * sizeof (*s->running));
+    s->nr_parked = 0;
+}
+
+/*
+ * Records the cur_nonce an element reported after a kernel run.
+ */
+void nonce_sched_progress(nonce_sched_t *s, int elm, uint32_t cur_nonce)
+{
+    nonce_range_t *r = s->ranges + elm;
+    r->cur += (uint32_t)(cur_nonce - (uint32_t)r->cur);
+    s->running[elm] = false;
+}
+
+/*
+ * Gives a range to the elements first to first + nr - 1 that are not parked
+ * and have no nonce left (the caller reports their progress beforehand): a
+ * new chunk while there are some, then half of the largest spare range of any
+ * element. Parked elements get the dummy range 0-0 (a full 2^32 range for the
+ * kernel). The ranges of these elements are then running.
+ *
+ * Returns false iff all of these elements are parked.
+ */
+bool nonce_sched_refill(nonce_sched_t *s, int first, int nr)
+{
+    bool scanning = false;
+    s->heap_len = 0;
+    for (int i = 0; i < s->nr_elms; i++)
+        if (!s->parked[i] && left(s, i))
+            s->heap[s->heap_len++] = i;
+    for (int i = s->heap_len / 2 - 1; i >= 0; i--)
+        sift_down(s, i);
+    for (int i = first; i < first + nr; i++)
+      {
+        nonce_range_t *r = s->ranges + i;
+        if (s->parked[i] || left(s, i))
+            continue;
+        if (s->nr_todo)
+          {
+            nonce_range_t *t = s->todo + s->nr_todo - 1;
+            r->cur = t->cur;
+            r->end = t->end - t->cur > s->chunk ? t->cur + s->chunk : t->end;
+            if ((t->cur = r->end) == t->end)
+                s->nr_todo--;
+            heap_push(s, i);
+            continue;
+          }
+        // steal the upper half of the largest spare range
+        if (s->heap_len && spare(s, s->heap[0]) >= 2 * (uint64_t)s->min_split)
+          {
+            int victim = heap_pop(s);
+            nonce_range_t *v = s->ranges + victim;
+            uint64_t half = spare(s, victim) / 2;
+            r->end = v->end;
+            r->cur = v->end = v->end - half;
+            heap_push(s, victim);
+            heap_push(s, i);
+            continue;
+          }
+        s->parked[i] = true;
+        s->nr_parked++;
+        r->cur = r->end = 0;
+      }
+    for (int i = first; i < first + nr; i++)
+        if (!s->parked[i])
+            scanning = s->running[i] = true;
+    return scanning;
+}
+
+/*
+ * Returns the number of nonces not scanned yet.
+ */
+uint64_t nonce_sched_left(const nonce_sched_t *s)
+{
+    uint64_t n = 0;
+    for (int i = 0; i < s->nr_todo; i++)
+        n += s->todo[i].end - s->todo[i].cur;
+    for (int i = 0; i < s->nr_elms; i++)
+        n += left(s, i);
+    return n;
+}
+
+/*
+ * Takes back every range not scanned yet, and parks all the elements. Stores
+ * in *left a malloc'ed array of them, and returns their number.
+ */
+int nonce_sched_take_left(nonce_sched_t *s, nonce_range_t **left_out)
+{
+    int n = 0;
+    nonce_range_t *l = malloc((s->nr_todo + s->nr_elms) * sizeof (*l));
+    if (!l)
+        perror("malloc"), exit(1);
+    for (int i = s->nr_todo - 1; i >= 0; i--)
+        l[n++] = s->todo[i];
+    for (int i = 0; i < s->nr_elms; i++)
+      {
+        if (left(s, i))
+            l[n++] = s->ranges[i];
+        s->ranges[i].cur = s->ranges[i].end = 0;
+        s->parked[i] = true;
+        s->running[i] = false;
+      }
+    s->nr_todo = 0;
+    s->nr_parked = s->nr_elms;
+    *left_out = l;
+    return n;
+}
+
+void nonce_sched_free(nonce_sched_t *s)
+{
+    free(s->ranges);
+    free(s->parked);
+    free(s->running);
+    free(s->heap);
+    free(s->todo);
+}
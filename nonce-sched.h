@@ -0,0 +1,49 @@
+/*
+ * Hands out the nonces of a work item to the elements of a device in chunks,
+ * on demand, instead of one fixed slice per element. An element that ran out
+ * of nonces steals half of the largest range left to another element of the
+ * device. When there is nothing left worth splitting, the element is parked:
+ * the kernel still runs it (over a dummy range), but the host ignores its
+ * results until the device moves to new work. Every nonce handed to the
+ * scheduler is thus scanned exactly once, unless the caller takes back what
+ * is left (nonce_sched_take_left) to carry it over to another run.
+ *
+ * Ranges are 64-bit so that the whole 2^32 nonce space is one range.
+ *
+ * The elements may be split in groups run separately (one per state table of
+ * the device). Ranges handed out are running until their progress is reported:
+ * a run scans at most max_run nonces of each element, so only what is beyond
+ * can be stolen from them meanwhile.
+ */
+
+typedef struct
+{
+    uint64_t	cur;	// next nonce to scan
+    uint64_t	end;	// exclusive, cur == end means nothing left
+}		nonce_range_t;
+
+typedef struct
+{
+    int			nr_elms;
+    uint32_t		chunk;		// nonces per chunk
+    uint32_t		min_split;	// never leave less than this to an element
+    uint32_t		max_run;	// nonces an element scans at most per run
+    nonce_range_t	*todo;		// not handed out yet
+    int			nr_todo;
+    int			max_todo;
+    nonce_range_t	*ranges;	// what each element is scanning
+    bool		*parked;	// host shadow flag of each element
+    bool		*running;	// range handed out, progress not reported
+    int			nr_parked;
+    int			*heap;		// elements by decreasing nonces to steal
+    int			heap_len;
+}		nonce_sched_t;
+
+void nonce_sched_init(nonce_sched_t *s, int nr_elms, uint32_t chunk,
+        uint32_t min_split, uint32_t max_run);
+void nonce_sched_reset(nonce_sched_t *s, const nonce_range_t *todo, int nr);
+void nonce_sched_progress(nonce_sched_t *s, int elm, uint32_t cur_nonce);
+bool nonce_sched_refill(nonce_sched_t *s, int first, int nr);
+uint64_t nonce_sched_left(const nonce_sched_t *s);
+int nonce_sched_take_left(nonce_sched_t *s, nonce_range_t **left);
+void nonce_sched_free(nonce_sched_t *s);
@@ -0,0 +1,28 @@
+/*
+ * AVX2 engine: 8 nonces per pass. Must be compiled with -mavx2, and only be
+ * called on CPUs supporting AVX2.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <immintrin.h>
+
+#include "sha256-utils.h"
+
+#define LANES		8
+typedef __m256i		vec_t;
+#define SCAN_FN		sha256d_scan_avx2
+#define V_SET1(x)	_mm256_set1_epi32(x)
+#define V_LANE_IDS	_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)
+#define V_ADD(a, b)	_mm256_add_epi32(a, b)
+#define V_XOR3(a, b, c)	_mm256_xor_si256(_mm256_xor_si256(a, b), c)
+#define V_ROR(x, n)	_mm256_or_si256(_mm256_srli_epi32(x, n), \
+                                _mm256_slli_epi32(x, 32 - (n)))
+#define V_SHR(x, n)	_mm256_srli_epi32(x, n)
+#define V_CH(e, f, g)	_mm256_xor_si256(g, \
+                                _mm256_and_si256(e, _mm256_xor_si256(f, g)))
+#define V_MAJ(a, b, c)	_mm256_or_si256(_mm256_and_si256(a, b), \
+                                _mm256_and_si256(c, _mm256_or_si256(a, b)))
+#define V_EQ_MASK(x, v)	(uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps( \
+                                _mm256_cmpeq_epi32(x, V_SET1(v))))
+
+#include "sha256-simd.h"
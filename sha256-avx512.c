@@ -0,0 +1,29 @@
+/*
+ * AVX-512 engine: 16 nonces per pass. Must be compiled with -mavx512f, and
+ * only be called on CPUs supporting AVX-512F.
+ *
+ * vpternlogd does for ch and maj what BFI_INT does on Evergreen (and also
+ * merges the 3-way XORs of the sigma functions), and vprord replaces the
+ * shift/shift/or rotates that bitalign replaces in the IL kernel.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <immintrin.h>
+
+#include "sha256-utils.h"
+
+#define LANES		16
+typedef __m512i		vec_t;
+#define SCAN_FN		sha256d_scan_avx512
+#define V_SET1(x)	_mm512_set1_epi32(x)
+#define V_LANE_IDS	_mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, \
+                                8, 9, 10, 11, 12, 13, 14, 15)
+#define V_ADD(a, b)	_mm512_add_epi32(a, b)
+#define V_XOR3(a, b, c)	_mm512_ternarylogic_epi32(a, b, c, 0x96)
+#define V_ROR(x, n)	_mm512_ror_epi32(x, n)
+#define V_SHR(x, n)	_mm512_srli_epi32(x, n)
+#define V_CH(e, f, g)	_mm512_ternarylogic_epi32(e, f, g, 0xca)
+#define V_MAJ(a, b, c)	_mm512_ternarylogic_epi32(a, b, c, 0xe8)
+#define V_EQ_MASK(x, v)	(uint32_t)_mm512_cmpeq_epi32_mask(x, V_SET1(v))
+
+#include "sha256-simd.h"
@@ -0,0 +1,121 @@
+/*
+ * SHA-NI engine: both compressions run on the SHA extensions (sha256rnds2
+ * does 2 rounds, sha256msg1/sha256msg2 blend 4 words). The latency of
+ * sha256rnds2 is hidden by hashing WAYS nonces in interleaved instruction
+ * streams. Must be compiled with -msha -msse4.1, and only be called on CPUs
+ * supporting SHA-NI.
+ *
+ * The state is held as in the Intel reference code: ABEF and CDGH, with A
+ * and C in the most significant words.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <immintrin.h>
+
+#include "sha256-utils.h"
+
+#define WAYS		2
+// repeat a statement for each of the interleaved nonces
+#define X2(stmt)	do { { enum { j = 0 }; stmt; } \
+                             { enum { j = 1 }; stmt; } } while (0)
+
+// rounds i..i+3 with message words msg
+#define RNDS4(st0, st1, msg, i)						\
+    do {								\
+        __m128i t_ = _mm_add_epi32(msg,					\
+                _mm_loadu_si128((const __m128i *)(sha256_k + (i))));	\
+        st1 = _mm_sha256rnds2_epu32(st1, st0, t_);			\
+        st0 = _mm_sha256rnds2_epu32(st0, st1, _mm_shuffle_epi32(t_, 0x0e)); \
+    } while (0)
+// computes the next 4 message words in m0 from the previous 16
+#define SCHED(m0, m1, m2, m3)						\
+    (m0 = _mm_sha256msg2_epu32(_mm_add_epi32(_mm_sha256msg1_epu32(m0, m1), \
+                    _mm_alignr_epi8(m3, m2, 4)), m3))
+// 4 rounds with the 4 message words computed in a
+#define GROUP(a, b, c, d, i)						\
+    do {								\
+        X2(SCHED(a[j], b[j], c[j], d[j]));				\
+        X2(RNDS4(s0[j], s1[j], a[j], i));				\
+    } while (0)
+#define GROUPS4(i)							\
+    do {								\
+        GROUP(m0, m1, m2, m3, i); GROUP(m1, m2, m3, m0, i + 4);		\
+        GROUP(m2, m3, m0, m1, i + 8); GROUP(m3, m0, m1, m2, i + 12);	\
+    } while (0)
+
+/*
+ * Stores in e60[] E of round 60 of the second hash of the nonces n and n + 1,
+ * ie. the H word of their double hash minus the initial H value.
+ */
+static void sha256d_e60_2way(const sha256_work_t *wk, uint32_t n,
+        uint32_t e60[WAYS])
+{
+    const uint32_t *st = wk->st4;
+    const uint32_t *h0 = sha256_h0;
+    __m128i s0[WAYS], s1[WAYS], m0[WAYS], m1[WAYS], m2[WAYS], m3[WAYS];
+    __m128i mid0 = _mm_loadu_si128((const __m128i *)wk->midstate);
+    __m128i mid1 = _mm_loadu_si128((const __m128i *)(wk->midstate + 4));
+
+    // first hash, from the state after round 3 (the nonce adds to A and E)
+    X2(s0[j] = _mm_set_epi32(st[0] + n + j, st[1], st[4] + n + j, st[5]));
+    X2(s1[j] = _mm_set_epi32(st[2], st[3], st[6], st[7]));
+    X2(m0[j] = _mm_setr_epi32(wk->data[0], wk->data[1], wk->data[2], n + j));
+    X2(m1[j] = _mm_setr_epi32(0x80000000, 0, 0, 0));
+    X2(m2[j] = _mm_setzero_si128());
+    X2(m3[j] = _mm_setr_epi32(0, 0, 0, 0x280));
+    X2(RNDS4(s0[j], s1[j], m1[j], 4));
+    X2(RNDS4(s0[j], s1[j], m2[j], 8));
+    X2(RNDS4(s0[j], s1[j], m3[j], 12));
+    GROUPS4(16); GROUPS4(32); GROUPS4(48);
+    // back to A..H order, plus the midstate: words 0-7 of the second hash
+    X2((m0[j] = _mm_shuffle_epi32(s0[j], 0x1b),		/* FEBA */
+        m1[j] = _mm_shuffle_epi32(s1[j], 0xb1),		/* DCHG */
+        s0[j] = _mm_blend_epi16(m0[j], m1[j], 0xf0),	/* DCBA */
+        s1[j] = _mm_alignr_epi8(m1[j], m0[j], 8)));	/* HGFE */
+    X2(m0[j] = _mm_add_epi32(s0[j], mid0));
+    X2(m1[j] = _mm_add_epi32(s1[j], mid1));
+    X2(m2[j] = _mm_setr_epi32(0x80000000, 0, 0, 0));
+    X2(m3[j] = _mm_setr_epi32(0, 0, 0, 0x100));
+
+    // second hash
+    X2(s0[j] = _mm_set_epi32(h0[0], h0[1], h0[4], h0[5]));
+    X2(s1[j] = _mm_set_epi32(h0[2], h0[3], h0[6], h0[7]));
+    X2(RNDS4(s0[j], s1[j], m0[j], 0));
+    X2(RNDS4(s0[j], s1[j], m1[j], 4));
+    X2(RNDS4(s0[j], s1[j], m2[j], 8));
+    X2(RNDS4(s0[j], s1[j], m3[j], 12));
+    GROUPS4(16); GROUPS4(32);
+    GROUP(m0, m1, m2, m3, 48); GROUP(m1, m2, m3, m0, 52);
+    GROUP(m2, m3, m0, m1, 56);
+    // after rounds 60-61, F is E of round 60: the last rounds are not needed
+    X2(SCHED(m3[j], m0[j], m1[j], m2[j]));
+    X2(s1[j] = _mm_sha256rnds2_epu32(s1[j], s0[j], _mm_add_epi32(m3[j],
+                    _mm_loadu_si128((const __m128i *)(sha256_k + 60)))));
+    X2(e60[j] = (uint32_t)_mm_cvtsi128_si32(s1[j]));
+}
+
+bool sha256d_scan_shani(const sha256_work_t *wk, uint32_t *cur_nonce,
+        uint32_t end_nonce, unsigned max_hashes)
+{
+    uint32_t n = *cur_nonce;
+    uint32_t remaining = end_nonce - n; // zero means 2^32
+    unsigned todo = max_hashes;
+    if (remaining && remaining < todo)
+        todo = remaining;
+    while (todo)
+      {
+        uint32_t e60[WAYS];
+        unsigned batch = todo < WAYS ? todo : WAYS;
+        sha256d_e60_2way(wk, n, e60);
+        for (unsigned j = 0; j < batch; j++)
+            if (e60[j] == -sha256_h0[7])
+              {
+                *cur_nonce = n + j + 1;
+                return true;
+              }
+        n += batch;
+        todo -= batch;
+      }
+    *cur_nonce = n;
+    return false;
+}
@@ -0,0 +1,188 @@
+/*
+ * Data-parallel double SHA-256 nonce scanner, hashing LANES consecutive
+ * nonces per pass, just like the IL kernel hashes 4 nonces per thread in the
+ * x,y,z,w components. This file is a template without include guards: it is
+ * included by each SIMD engine after defining:
+ *
+ *   LANES             number of 32-bit lanes of a vector (at most 32)
+ *   vec_t             vector type
+ *   SCAN_FN           name of the sha256d_scan_fn to define
+ *   V_SET1(x)         broadcast a 32-bit word
+ *   V_LANE_IDS        vector of 0, 1, ..., LANES - 1
+ *   V_ADD(a, b)       lane-wise addition
+ *   V_XOR3(a, b, c)   a ^ b ^ c
+ *   V_ROR(x, n)       rotate right
+ *   V_SHR(x, n)       shift right
+ *   V_CH(e, f, g)     e ? f : g (bit select)
+ *   V_MAJ(a, b, c)    bitwise majority
+ *   V_EQ_MASK(x, v)   bitmask of the lanes of x equal to the 32-bit word v
+ *
+ * Only the H word of the second hash is computed, and constant data words
+ * (padding of both hashes) are folded by hand.
+ */
+
+#define T_ROR(x, n)	(((uint32_t)(x) >> (n)) | ((uint32_t)(x) << (32 - (n))))
+#define T_S0(x)		(T_ROR(x, 2) ^ T_ROR(x, 13) ^ T_ROR(x, 22))
+#define T_S1(x)		(T_ROR(x, 6) ^ T_ROR(x, 11) ^ T_ROR(x, 25))
+#define T_s0(x)		(T_ROR(x, 7) ^ T_ROR(x, 18) ^ ((uint32_t)(x) >> 3))
+#define T_s1(x)		(T_ROR(x, 17) ^ T_ROR(x, 19) ^ ((uint32_t)(x) >> 10))
+
+#define V_S0(x)		V_XOR3(V_ROR(x, 2), V_ROR(x, 13), V_ROR(x, 22))
+#define V_S1(x)		V_XOR3(V_ROR(x, 6), V_ROR(x, 11), V_ROR(x, 25))
+#define V_s0(x)		V_XOR3(V_ROR(x, 7), V_ROR(x, 18), V_SHR(x, 3))
+#define V_s1(x)		V_XOR3(V_ROR(x, 17), V_ROR(x, 19), V_SHR(x, 10))
+
+// full round
+#define RND(a, b, c, d, e, f, g, h, kw)					\
+    do {								\
+        vec_t t1 = V_ADD(V_ADD(V_ADD(h, V_S1(e)), V_CH(e, f, g)), kw);	\
+        d = V_ADD(d, t1);						\
+        h = V_ADD(V_ADD(t1, V_S0(a)), V_MAJ(a, b, c));			\
+    } while (0)
+// round computing only the new E (for the last rounds of the second hash)
+#define RNDE(a, b, c, d, e, f, g, h, kw)				\
+    do {								\
+        (void)a; (void)b; (void)c;					\
+        d = V_ADD(d, V_ADD(V_ADD(V_ADD(h, V_S1(e)), V_CH(e, f, g)), kw)); \
+    } while (0)
+
+// rounds 8n+0 .. 8n+7: the names of A..H rotate instead of the values
+#define R_0(x)		RND(a, b, c, d, e, f, g, h, x)
+#define R_1(x)		RND(h, a, b, c, d, e, f, g, x)
+#define R_2(x)		RND(g, h, a, b, c, d, e, f, x)
+#define R_3(x)		RND(f, g, h, a, b, c, d, e, x)
+#define R_4(x)		RND(e, f, g, h, a, b, c, d, x)
+#define R_5(x)		RND(d, e, f, g, h, a, b, c, x)
+#define R_6(x)		RND(c, d, e, f, g, h, a, b, x)
+#define R_7(x)		RND(b, c, d, e, f, g, h, a, x)
+#define KW(i)		V_ADD(V_SET1(sha256_k[i]), w[i])
+#define KC(i, c)	V_SET1(sha256_k[i] + (c))
+#define R_8(i)								\
+    do {								\
+        R_0(KW(i)); R_1(KW(i + 1)); R_2(KW(i + 2)); R_3(KW(i + 3));	\
+        R_4(KW(i + 4)); R_5(KW(i + 5)); R_6(KW(i + 6)); R_7(KW(i + 7));	\
+    } while (0)
+#define BLEND(i)							\
+    (w[i] = V_ADD(V_ADD(V_s1(w[i - 2]), w[i - 7]),			\
+                  V_ADD(V_s0(w[i - 15]), w[i - 16])))
+
+/*
+ * Returns E of round 60 of the second hash of LANES nonces, ie. the H word of
+ * the double hash minus the initial H value.
+ */
+static vec_t sha256d_e60(const sha256_work_t *wk, vec_t nonce,
+        const uint32_t h2[2])
+{
+    vec_t w[64];
+    vec_t a, b, c, d, e, f, g, h;
+
+    // first hash, from the state after round 3 (round 4 uses the R_4 names)
+    e = V_ADD(V_SET1(wk->st4[0]), nonce);
+    f = V_SET1(wk->st4[1]);
+    g = V_SET1(wk->st4[2]);
+    h = V_SET1(wk->st4[3]);
+    a = V_ADD(V_SET1(wk->st4[4]), nonce);
+    b = V_SET1(wk->st4[5]);
+    c = V_SET1(wk->st4[6]);
+    d = V_SET1(wk->st4[7]);
+    R_4(KC(4, 0x80000000)); R_5(KC(5, 0)); R_6(KC(6, 0)); R_7(KC(7, 0));
+    R_0(KC(8, 0)); R_1(KC(9, 0)); R_2(KC(10, 0)); R_3(KC(11, 0));
+    R_4(KC(12, 0)); R_5(KC(13, 0)); R_6(KC(14, 0)); R_7(KC(15, 0x280));
+    w[16] = V_SET1(wk->w16);
+    w[17] = V_SET1(wk->w17);
+    w[18] = V_ADD(V_s0(nonce), V_SET1(wk->w18));
+    w[19] = V_ADD(nonce, V_SET1(wk->w19));
+    w[20] = V_ADD(V_s1(w[18]), V_SET1(0x80000000));
+    w[21] = V_s1(w[19]);
+    w[22] = V_ADD(V_s1(w[20]), V_SET1(0x280));
+    w[23] = V_ADD(V_s1(w[21]), w[16]);
+    w[24] = V_ADD(V_s1(w[22]), w[17]);
+    for (int i = 25; i < 30; i++)
+        w[i] = V_ADD(V_s1(w[i - 2]), w[i - 7]);
+    w[30] = V_ADD(V_ADD(V_s1(w[28]), w[23]), V_SET1(T_s0(0x280)));
+    w[31] = V_ADD(V_ADD(V_s1(w[29]), w[24]), V_SET1(wk->w31));
+    for (int i = 32; i < 64; i++)
+        BLEND(i);
+    R_8(16); R_8(24); R_8(32); R_8(40); R_8(48); R_8(56);
+
+    // second hash: its data words 0-7 are the first hash
+    w[0] = V_ADD(a, V_SET1(wk->midstate[0]));
+    w[1] = V_ADD(b, V_SET1(wk->midstate[1]));
+    w[2] = V_ADD(c, V_SET1(wk->midstate[2]));
+    w[3] = V_ADD(d, V_SET1(wk->midstate[3]));
+    w[4] = V_ADD(e, V_SET1(wk->midstate[4]));
+    w[5] = V_ADD(f, V_SET1(wk->midstate[5]));
+    w[6] = V_ADD(g, V_SET1(wk->midstate[6]));
+    w[7] = V_ADD(h, V_SET1(wk->midstate[7]));
+    // round 0 only depends on w[0] (round 1 uses the R_1 names)
+    h = V_ADD(V_SET1(h2[0]), w[0]);
+    a = V_SET1(sha256_h0[0]);
+    b = V_SET1(sha256_h0[1]);
+    c = V_SET1(sha256_h0[2]);
+    d = V_ADD(V_SET1(h2[1]), w[0]);
+    e = V_SET1(sha256_h0[4]);
+    f = V_SET1(sha256_h0[5]);
+    g = V_SET1(sha256_h0[6]);
+    R_1(KW(1)); R_2(KW(2)); R_3(KW(3));
+    R_4(KW(4)); R_5(KW(5)); R_6(KW(6)); R_7(KW(7));
+    R_0(KC(8, 0x80000000)); R_1(KC(9, 0)); R_2(KC(10, 0)); R_3(KC(11, 0));
+    R_4(KC(12, 0)); R_5(KC(13, 0)); R_6(KC(14, 0)); R_7(KC(15, 0x100));
+    w[16] = V_ADD(V_s0(w[1]), w[0]);
+    w[17] = V_ADD(V_ADD(V_s0(w[2]), w[1]), V_SET1(T_s1(0x100)));
+    for (int i = 18; i < 22; i++)
+        w[i] = V_ADD(V_ADD(V_s1(w[i - 2]), V_s0(w[i - 15])), w[i - 16]);
+    w[22] = V_ADD(V_ADD(V_s1(w[20]), V_s0(w[7])),
+            V_ADD(w[6], V_SET1(0x100)));
+    w[23] = V_ADD(V_ADD(V_s1(w[21]), w[16]),
+            V_ADD(w[7], V_SET1(T_s0(0x80000000))));
+    w[24] = V_ADD(V_ADD(V_s1(w[22]), w[17]), V_SET1(0x80000000));
+    for (int i = 25; i < 30; i++)
+        w[i] = V_ADD(V_s1(w[i - 2]), w[i - 7]);
+    w[30] = V_ADD(V_ADD(V_s1(w[28]), w[23]), V_SET1(T_s0(0x100)));
+    w[31] = V_ADD(V_ADD(V_s1(w[29]), w[24]),
+            V_ADD(V_s0(w[16]), V_SET1(0x100)));
+    for (int i = 32; i < 61; i++)
+        BLEND(i);
+    R_8(16); R_8(24); R_8(32); R_8(40); R_8(48);
+    R_0(KW(56)); R_1(KW(57));
+    // H of the result is E of round 60 plus the initial H value
+    RNDE(g, h, a, b, c, d, e, f, KW(58));
+    RNDE(f, g, h, a, b, c, d, e, KW(59));
+    RNDE(e, f, g, h, a, b, c, d, KW(60));
+    return h;
+}
+
+bool SCAN_FN(const sha256_work_t *wk, uint32_t *cur_nonce,
+        uint32_t end_nonce, unsigned max_hashes)
+{
+    uint32_t n = *cur_nonce;
+    uint32_t remaining = end_nonce - n; // zero means 2^32
+    unsigned todo = max_hashes;
+    // values of round 0 of the second hash that do not depend on the data
+    uint32_t t1 = sha256_h0[7] + T_S1(sha256_h0[4]) +
+        (sha256_h0[6] ^ (sha256_h0[4] & (sha256_h0[5] ^ sha256_h0[6]))) +
+        sha256_k[0];
+    uint32_t t2 = T_S0(sha256_h0[0]) +
+        ((sha256_h0[0] & sha256_h0[1]) |
+         (sha256_h0[2] & (sha256_h0[0] | sha256_h0[1])));
+    const uint32_t h2[2] = { t1 + t2, sha256_h0[3] + t1 };
+    if (remaining && remaining < todo)
+        todo = remaining;
+    while (todo)
+      {
+        unsigned batch = todo < LANES ? todo : LANES;
+        vec_t e60 = sha256d_e60(wk, V_ADD(V_SET1(n), V_LANE_IDS), h2);
+        uint32_t found = V_EQ_MASK(e60, -sha256_h0[7]);
+        if (batch < LANES)
+            found &= (1U << batch) - 1;
+        if (found)
+          {
+            *cur_nonce = n + __builtin_ctz(found) + 1;
+            return true;
+          }
+        n += batch;
+        todo -= batch;
+      }
+    *cur_nonce = n;
+    return false;
+}
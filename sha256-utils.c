@@ -0,0 +1,223 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "sha256-utils.h"
+
+const uint32_t sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+    0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+    0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+    0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+    0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+const uint32_t sha256_h0[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+};
+
+/*
+ * A block solved by nonce 0x00d3fb29 (words of the second 64-byte data block
+ * and midstate), used as dummy work and as a known answer.
+ */
+const uint32_t sha256_test_data[16] = {
+    0x044c8720, 0x5c820c4d, 0x0812451c, 0x00d3fb29,
+    0x80000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000280,
+};
+const uint32_t sha256_test_midstate[8] = {
+    0x6058cb5a, 0xde72384e, 0xfae38d3c, 0xf6212e39,
+    0x0cfb5a2f, 0x20ebe629, 0x9ce9ce77, 0xc2fb5a3f,
+};
+const uint32_t sha256_test_nonce = 0x00d3fb29;
+
+#define ROR(x, n)	(((x) >> (n)) | ((x) << (32 - (n))))
+#define S0(x)		(ROR(x, 2) ^ ROR(x, 13) ^ ROR(x, 22))
+#define S1(x)		(ROR(x, 6) ^ ROR(x, 11) ^ ROR(x, 25))
+#define s0(x)		(ROR(x, 7) ^ ROR(x, 18) ^ ((x) >> 3))
+#define s1(x)		(ROR(x, 17) ^ ROR(x, 19) ^ ((x) >> 10))
+#define CH(e, f, g)	((g) ^ ((e) & ((f) ^ (g))))
+#define MAJ(a, b, c)	(((a) & (b)) | ((c) & ((a) | (b))))
+
+/*
+ * One round on state[] (A..H), kw being k[i] + w[i].
+ */
+static void sha256_round(uint32_t s[8], uint32_t kw)
+{
+    uint32_t t1 = s[7] + S1(s[4]) + CH(s[4], s[5], s[6]) + kw;
+    uint32_t t2 = S0(s[0]) + MAJ(s[0], s[1], s[2]);
+    memmove(s + 1, s, 7 * sizeof (*s));
+    s[4] += t1;
+    s[0] = t1 + t2;
+}
+
+/*
+ * Rounds first..63 on s[] (A..H), with the 64 expanded data words w[].
+ */
+static void sha256_rounds(uint32_t s[8], const uint32_t w[64], int first)
+{
+    uint32_t a = s[0], b = s[1], c = s[2], d = s[3];
+    uint32_t e = s[4], f = s[5], g = s[6], h = s[7];
+    for (int i = first; i < 64; i++)
+      {
+        uint32_t t1 = h + S1(e) + CH(e, f, g) + sha256_k[i] + w[i];
+        uint32_t t2 = S0(a) + MAJ(a, b, c);
+        h = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+      }
+    s[0] = a; s[1] = b; s[2] = c; s[3] = d;
+    s[4] = e; s[5] = f; s[6] = g; s[7] = h;
+}
+
+void sha256_transform(uint32_t state[8], const uint32_t data[16])
+{
+    uint32_t w[64], s[8];
+    memcpy(w, data, 16 * sizeof (*w));
+    for (int i = 16; i < 64; i++)
+        w[i] = s1(w[i - 2]) + w[i - 7] + s0(w[i - 15]) + w[i - 16];
+    memcpy(s, state, sizeof (s));
+    sha256_rounds(s, w, 0);
+    for (int i = 0; i < 8; i++)
+        state[i] += s[i];
+}
+
+/*
+ * Transforms state with a 64-byte block, read as big-endian words.
+ */
+static void sha256_block(uint32_t state[8], const uint8_t block[64])
+{
+    uint32_t data[16];
+    for (int i = 0; i < 16; i++)
+        data[i] = (uint32_t)block[4 * i] << 24 | block[4 * i + 1] << 16 |
+            block[4 * i + 2] << 8 | block[4 * i + 3];
+    sha256_transform(state, data);
+}
+
+/*
+ * Plain SHA-256 of len bytes, as a big-endian digest.
+ */
+void sha256(const void *buf, size_t len, uint8_t hash[32])
+{
+    const uint8_t *p = buf;
+    uint32_t state[8];
+    uint8_t block[64] = { 0 };
+    size_t rem = len % 64;
+    memcpy(state, sha256_h0, sizeof (state));
+    for (size_t i = 0; i < len - rem; i += 64)
+        sha256_block(state, p + i);
+    // padding: 0x80, zeros, then the bit length in the last 8 bytes
+    memcpy(block, p + len - rem, rem);
+    block[rem] = 0x80;
+    if (rem >= 56)
+      {
+        sha256_block(state, block);
+        memset(block, 0, sizeof (block));
+      }
+    for (int i = 0; i < 8; i++)
+        block[63 - i] = (uint64_t)len * 8 >> (8 * i);
+    sha256_block(state, block);
+    for (int i = 0; i < 32; i++)
+        hash[i] = state[i / 4] >> (24 - 8 * (i % 4));
+}
+
+/*
+ * Extracts from a getwork item (as decoded by work_decode) the values needed
+ * to hash it, and computes once the parts of the first hash that are the same
+ * for every nonce. Words 4-15 of the second data block are the padding:
+ * 0x80000000, zeros, and the message length 0x280.
+ */
+void sha256_work_init(sha256_work_t *w, const uint32_t datawords[32],
+        const uint32_t midstate[8])
+{
+    const uint32_t *d = w->data;
+    memcpy(w->midstate, midstate, sizeof (w->midstate));
+    memcpy(w->data, datawords + 16, sizeof (w->data));
+    // rounds 0-3; the nonce only contributes linearly to t1 of round 3
+    memcpy(w->st4, midstate, sizeof (w->st4));
+    for (int i = 0; i < 4; i++)
+        sha256_round(w->st4, sha256_k[i] + (i < 3 ? d[i] : 0));
+    w->w16 = s0(d[1]) + d[0];
+    w->w17 = s1(0x280U) + s0(d[2]) + d[1];
+    w->w18 = s1(w->w16) + d[2];
+    w->w19 = s1(w->w17) + s0(0x80000000);
+    w->w31 = s0(w->w16) + 0x280;
+}
+
+/*
+ * Returns the H word of the double SHA-256 of the block header with the
+ * given nonce, ie. the value the kernel compares against zero.
+ */
+uint32_t sha256d_h(const sha256_work_t *w, uint32_t nonce)
+{
+    uint32_t state[8];
+    uint32_t data[16] = {
+        w->data[0], w->data[1], w->data[2], nonce,
+        0x80000000, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x280,
+    };
+    memcpy(state, w->midstate, sizeof (state));
+    sha256_transform(state, data);
+    memcpy(data, state, sizeof (state));
+    data[8] = 0x80000000;
+    memset(data + 9, 0, 6 * sizeof (*data));
+    data[15] = 0x100;
+    memcpy(state, sha256_h0, sizeof (state));
+    sha256_transform(state, data);
+    return state[7];
+}
+
+/*
+ * Same as sha256d_h, but starting from the values precomputed by
+ * sha256_work_init, like the kernel does.
+ */
+static uint32_t sha256d_h_pre(const sha256_work_t *w, uint32_t nonce)
+{
+    uint32_t state[8], data[64] = { [4] = 0x80000000, [15] = 0x280 };
+    memcpy(state, w->st4, sizeof (state));
+    state[0] += nonce;
+    state[4] += nonce;
+    data[16] = w->w16;
+    data[17] = w->w17;
+    data[18] = w->w18 + s0(nonce);
+    data[19] = w->w19 + nonce;
+    for (int i = 20; i < 64; i++)
+        data[i] = s1(data[i - 2]) + data[i - 7] + s0(data[i - 15]) +
+            data[i - 16];
+    sha256_rounds(state, data, 4);
+    for (int i = 0; i < 8; i++)
+        data[i] = state[i] + w->midstate[i];
+    data[8] = 0x80000000;
+    memset(data + 9, 0, 6 * sizeof (*data));
+    data[15] = 0x100;
+    memcpy(state, sha256_h0, sizeof (state));
+    sha256_transform(state, data);
+    return state[7];
+}
+
+bool sha256d_scan_scalar(const sha256_work_t *w, uint32_t *cur_nonce,
+        uint32_t end_nonce, unsigned max_hashes)
+{
+    uint32_t n = *cur_nonce;
+    bool found = false;
+    // same loop structure as the kernel: hash, increment, then test
+    for (unsigned i = 0; i < max_hashes; i++)
+      {
+        found = !sha256d_h_pre(w, n++);
+        if (found || n == end_nonce)
+            break;
+      }
+    *cur_nonce = n;
+    return found;
+}
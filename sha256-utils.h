@@ -0,0 +1,51 @@
+/*
+ * Host-side double SHA-256, computing exactly what the IL kernel computes.
+ */
+
+extern const uint32_t sha256_k[64];
+extern const uint32_t sha256_h0[8];
+extern const uint32_t sha256_test_data[16];
+extern const uint32_t sha256_test_midstate[8];
+extern const uint32_t sha256_test_nonce;
+
+/*
+ * Nonce-independent inputs of the double hash of one work item.
+ */
+typedef struct
+{
+    uint32_t	midstate[8];	// state after the first 64-byte data block
+    uint32_t	data[3];	// words 0-2 of the second 64-byte data block
+    // first hash values that do not depend on the nonce (word 3)
+    uint32_t	st4[8];		// A..H after rounds 0-3 for nonce 0 (the nonce
+				// only needs to be added to A and E)
+    uint32_t	w16, w17;	// words 16-17
+    uint32_t	w18;		// word 18 minus s0(nonce)
+    uint32_t	w19;		// word 19 minus the nonce
+    uint32_t	w31;		// s0(w16) + w15 part of word 31
+} sha256_work_t;
+
+/*
+ * Scans nonces from *cur_nonce up to end_nonce (exclusive), hashing at most
+ * max_hashes of them, and stops right after the first nonce whose double hash
+ * has a zero H word. On return *cur_nonce is one past the last nonce hashed,
+ * like the cur_nonce the kernel writes back. Just like the kernel, a range
+ * with *cur_nonce == end_nonce is treated as a full 2^32 range.
+ *
+ * Returns true iff a candidate was found (it is *cur_nonce - 1).
+ */
+typedef bool (*sha256d_scan_fn)(const sha256_work_t *w, uint32_t *cur_nonce,
+        uint32_t end_nonce, unsigned max_hashes);
+
+void sha256_transform(uint32_t state[8], const uint32_t data[16]);
+void sha256(const void *buf, size_t len, uint8_t hash[32]);
+void sha256_work_init(sha256_work_t *w, const uint32_t datawords[32],
+        const uint32_t midstate[8]);
+uint32_t sha256d_h(const sha256_work_t *w, uint32_t nonce);
+bool sha256d_scan_scalar(const sha256_work_t *w, uint32_t *cur_nonce,
+        uint32_t end_nonce, unsigned max_hashes);
+bool sha256d_scan_avx2(const sha256_work_t *w, uint32_t *cur_nonce,
+        uint32_t end_nonce, unsigned max_hashes);
+bool sha256d_scan_avx512(const sha256_work_t *w, uint32_t *cur_nonce,
+        uint32_t end_nonce, unsigned max_hashes);
+bool sha256d_scan_shani(const sha256_work_t *w, uint32_t *cur_nonce,
+        uint32_t end_nonce, unsigned max_hashes);
@@ -0,0 +1,102 @@
+#!/usr/bin/perl -w
+#
+# Writes to stdout tests/cal-object.elf, a synthetic ELF CALobject laid out as
+# cal_elf_parse expects: a PT_NOTE segment of "ATI CAL" notes, then a PT_LOAD
+# segment with the ISA, then one with the data. The ISA is a control flow
+# program followed by two ALU clauses and a vertex fetch clause. Its ALU
+# groups carry literal constants, some of which look like BFE_INT
+# instructions, so that they are only skipped over right if the literals of
+# each group are counted from the source operands.
+
+use strict;
+
+use constant {
+    ALU_SRC_LITERAL => 253,
+    OP3_INST_BFE_UINT => 4,
+    OP3_INST_BFE_INT => 5,
+    OP3_INST_BIT_ALIGN_INT => 12,
+    OP3_INST_BYTE_ALIGN_INT => 13,
+    OP2_INST_MOV => 0x10,
+    CF_INST_ALU => 8,
+    CF_INST_ALU_EXTENDED => 12,
+    CF_INST_VC => 2,
+};
+
+# ALU_WORD0/1_OP3; %o holds the sel and chan of the sources and the LAST bit
+sub op3
+{
+    my ($inst, %o) = @_;
+    my $lo = ($o{s0} // 0) | ($o{c0} // 0) << 10 | ($o{s1} // 0) << 13 |
+        ($o{c1} // 0) << 23 | ($o{last} ? 1 << 31 : 0);
+    my $hi = ($o{s2} // 0) | ($o{c2} // 0) << 10 | $inst << 13;
+    return $lo | $hi << 32;
+}
+
+# ALU_WORD0/1_OP2
+sub op2
+{
+    my ($inst, %o) = @_;
+    my $lo = ($o{s0} // 0) | ($o{c0} // 0) << 10 | ($o{s1} // 0) << 13 |
+        ($o{c1} // 0) << 23 | ($o{last} ? 1 << 31 : 0);
+    return $lo | ($inst << 7) << 32;
+}
+
+# CF_ALU_WORD0/1
+sub cf_alu
+{
+    my ($addr, $count, $inst) = @_;
+    return $addr | (($count - 1) << 18 | ($inst // CF_INST_ALU) << 26 |
+            1 << 31) << 32;
+}
+
+my $fake = op3(OP3_INST_BFE_INT); # a literal pair that looks like BFE_INT
+my @clause0 = (
+    # 3 literals, in 2 words
+    op3(OP3_INST_BFE_INT), op3(OP3_INST_BFE_UINT),
+    op3(OP3_INST_BIT_ALIGN_INT, s1 => ALU_SRC_LITERAL, c1 => 2),
+    op3(OP3_INST_BFE_INT, last => 1),
+    $fake, $fake,
+    # 1 literal, in 1 word
+    op2(OP2_INST_MOV, s0 => ALU_SRC_LITERAL, last => 1), 0x1111,
+    op3(OP3_INST_BYTE_ALIGN_INT), op3(OP3_INST_BFE_INT, last => 1));
+my @clause1 = (
+    op3(OP3_INST_BFE_INT, s2 => ALU_SRC_LITERAL, c2 => 1, last => 1), $fake,
+    op3(OP3_INST_BFE_INT, last => 1));
+my $alu0 = 6;
+my $alu1 = $alu0 + @clause0;
+my $vc = $alu1 + @clause1;
+my @cf = (
+    cf_alu($alu0, scalar @clause0),
+    cf_alu(0, 1, CF_INST_ALU_EXTENDED),
+    cf_alu($alu1, scalar @clause1),
+    ($vc + 1) | (CF_INST_VC << 22) << 32,
+    (1 << 21) << 32, # END_OF_PROGRAM
+    0);
+my $text = pack('Q<*', @cf, @clause0, @clause1) . "\0" x 16;
+
+my $notes = '';
+for my $type (1 .. 17)
+  {
+    my $desc = "\1\2\3\4" x ($type % 3);
+    $notes .= pack('VVV', 8, length $desc, $type) . "ATI CAL\0" . $desc;
+  }
+my @segs = (
+    [ 0x70000002, pack('V5', 9, 4, 0, 0, 0) ], # encoding dictionary
+    [ 4, $notes ], # PT_NOTE
+    [ 1, $text ], # PT_LOAD
+    [ 1, "\xaa" x 32 ]);
+
+my ($ehsize, $phentsize) = (52, 32);
+my $off = $ehsize + @segs * $phentsize;
+my ($ph, $body) = ('', '');
+for my $s (@segs)
+  {
+    my ($type, $blob) = @$s;
+    $ph .= pack('V8', $type, $off, 0, 0, length $blob, length $blob, 0, 0);
+    $body .= $blob;
+    $off += length $blob;
+  }
+binmode STDOUT;
+print "\x7fELF", pack('C5', 1, 1, 1, 100, 1), "\0" x 7,
+    pack('vvVVVVVvvvvvv', 2, 125, 1, 0, $ehsize, 0, 0, $ehsize, $phentsize,
+            scalar @segs, 40, 0, 0), $ph, $body;